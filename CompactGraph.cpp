@@ -0,0 +1,241 @@
+#include "CompactGraph.h"
+#include "Graph.h"
+#include "Node.h"
+
+template<size_t COLOR_COUNT>
+BasicCompactGraph<COLOR_COUNT>::BasicCompactGraph(const Graph &graph) : _maxCapacity(graph.getMaxCapacity()),
+                                                                       _wordCount((graph.getMaxCapacity() + 63) / 64)
+{
+    _outOffsets.resize(_maxCapacity + 1, 0);
+    _initialState.present.resize(_wordCount, 0);
+    _initialState.planes.resize(PLANE_COUNT * _wordCount, 0);
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        _outOffsets[i] = _outEdges.size();
+        if (!graph.nodeExists(i))
+        {
+            continue;
+        }
+        const Node &node = graph.getNode(i);
+        _initialState.present[i / 64] |= uint64_t(1) << (i % 64);
+        setColor(_initialState, i, node._color);
+        for (const NeighborList::Neighbor &neighbor: node._neighbors)
+        {
+            checkColor(neighbor.color);
+            _outEdges.push_back(Edge{static_cast<uint32_t>(neighbor.id), neighbor.color});
+        }
+    }
+    _outOffsets[_maxCapacity] = _outEdges.size();
+    buildInEdges();
+}
+
+template<size_t COLOR_COUNT>
+BasicCompactGraph<COLOR_COUNT>::BasicCompactGraph(const std::vector<GraphInterface::Color> &colors,
+                                                  std::vector<size_t> outOffsets, std::vector<Edge> outEdges)
+        : _maxCapacity(colors.size()), _wordCount((colors.size() + 63) / 64), _outOffsets(std::move(outOffsets)),
+          _outEdges(std::move(outEdges))
+{
+    if (_outOffsets.size() != _maxCapacity + 1 || _outOffsets.front() != 0 || _outOffsets.back() != _outEdges.size())
+    {
+        throw GraphInterface::GraphModificationException("Invalid edge offsets");
+    }
+    _initialState.present.resize(_wordCount, 0);
+    _initialState.planes.resize(PLANE_COUNT * _wordCount, 0);
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        if (_outOffsets[i] > _outOffsets[i + 1])
+        {
+            throw GraphInterface::GraphModificationException("Invalid edge offsets");
+        }
+        for (size_t e = _outOffsets[i]; e < _outOffsets[i + 1]; ++e)
+        {
+            if (_outEdges[e].node >= _maxCapacity || _outEdges[e].node == i
+                || (e > _outOffsets[i] && _outEdges[e].node <= _outEdges[e - 1].node))
+            {
+                throw GraphInterface::GraphModificationException("Invalid node index");
+            }
+            checkColor(_outEdges[e].color);
+        }
+        _initialState.present[i / 64] |= uint64_t(1) << (i % 64);
+        setColor(_initialState, i, colors[i]);
+    }
+    buildInEdges();
+}
+
+template<size_t COLOR_COUNT>
+void BasicCompactGraph<COLOR_COUNT>::checkColor(GraphInterface::Color color)
+{
+    if (static_cast<size_t>(color) >= COLOR_COUNT)
+    {
+        throw GraphInterface::GraphModificationException("Color out of range");
+    }
+}
+
+template<size_t COLOR_COUNT>
+uint64_t BasicCompactGraph<COLOR_COUNT>::getColorCode(GraphInterface::Color color)
+{
+    checkColor(color);
+    return ~static_cast<uint64_t>(color) & ((uint64_t(1) << PLANE_COUNT) - 1);
+}
+
+template<size_t COLOR_COUNT>
+void BasicCompactGraph<COLOR_COUNT>::setColor(State &state, size_t id, GraphInterface::Color color) const
+{
+    uint64_t code = getColorCode(color);
+    uint64_t mask = uint64_t(1) << (id % 64);
+    for (size_t p = 0; p < PLANE_COUNT; ++p)
+    {
+        uint64_t &word = state.planes[p * _wordCount + id / 64];
+        word = (code >> p) & 1 ? word | mask : word & ~mask;
+    }
+}
+
+template<size_t COLOR_COUNT>
+void BasicCompactGraph<COLOR_COUNT>::buildInEdges()
+{
+    _inOffsets.assign(_maxCapacity + 1, 0);
+    for (const Edge &edge: _outEdges)
+    {
+        _inOffsets[edge.node + 1]++;
+    }
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        _inOffsets[i + 1] += _inOffsets[i];
+    }
+    _inEdges.resize(_outEdges.size());
+    std::vector<size_t> inPositions(_inOffsets.begin(), _inOffsets.end() - 1);
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        for (size_t e = _outOffsets[i]; e < _outOffsets[i + 1]; ++e)
+        {
+            _inEdges[inPositions[_outEdges[e].node]++] = Edge{static_cast<uint32_t>(i), _outEdges[e].color};
+        }
+    }
+}
+
+template<size_t COLOR_COUNT>
+size_t BasicCompactGraph<COLOR_COUNT>::getMaxCapacity() const
+{
+    return _maxCapacity;
+}
+
+template<size_t COLOR_COUNT>
+size_t BasicCompactGraph<COLOR_COUNT>::getWordCount() const
+{
+    return _wordCount;
+}
+
+template<size_t COLOR_COUNT>
+const typename BasicCompactGraph<COLOR_COUNT>::State &BasicCompactGraph<COLOR_COUNT>::getInitialState() const
+{
+    return _initialState;
+}
+
+template<size_t COLOR_COUNT>
+typename BasicCompactGraph<COLOR_COUNT>::EdgeRange BasicCompactGraph<COLOR_COUNT>::getOutEdges(size_t id) const
+{
+    return EdgeRange(_outEdges.data() + _outOffsets[id], _outEdges.data() + _outOffsets[id + 1]);
+}
+
+template<size_t COLOR_COUNT>
+typename BasicCompactGraph<COLOR_COUNT>::EdgeRange BasicCompactGraph<COLOR_COUNT>::getInEdges(size_t id) const
+{
+    return EdgeRange(_inEdges.data() + _inOffsets[id], _inEdges.data() + _inOffsets[id + 1]);
+}
+
+template<size_t COLOR_COUNT>
+bool BasicCompactGraph<COLOR_COUNT>::nodeExists(const State &state, size_t id) const
+{
+    return id < _maxCapacity && (state.present[id / 64] >> (id % 64)) & 1;
+}
+
+template<size_t COLOR_COUNT>
+GraphInterface::Color BasicCompactGraph<COLOR_COUNT>::getColor(const State &state, size_t id) const
+{
+    uint64_t code = 0;
+    for (size_t p = 0; p < PLANE_COUNT; ++p)
+    {
+        code |= ((state.planes[p * _wordCount + id / 64] >> (id % 64)) & 1) << p;
+    }
+    return static_cast<GraphInterface::Color>(~code & ((uint64_t(1) << PLANE_COUNT) - 1));
+}
+
+template<size_t COLOR_COUNT>
+size_t BasicCompactGraph<COLOR_COUNT>::size(const State &state) const
+{
+    size_t count = 0;
+    for (uint64_t word: state.present)
+    {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+template<size_t COLOR_COUNT>
+void BasicCompactGraph<COLOR_COUNT>::removeNode(State &state, size_t id) const
+{
+    if (!nodeExists(state, id))
+    {
+        throw GraphInterface::GraphModificationException("Node does not exist");
+    }
+    for (const Edge &edge: getOutEdges(id))
+    {
+        size_t target = edge.node;
+        if (!(state.present[target / 64] & (uint64_t(1) << (target % 64))))
+        {
+            continue;
+        }
+        setColor(state, target, edge.color);
+    }
+    state.present[id / 64] &= ~(uint64_t(1) << (id % 64));
+    for (size_t p = 0; p < PLANE_COUNT; ++p)
+    {
+        state.planes[p * _wordCount + id / 64] &= ~(uint64_t(1) << (id % 64));
+    }
+}
+
+template<size_t COLOR_COUNT>
+uint64_t BasicCompactGraph<COLOR_COUNT>::hash(const State &state) const
+{
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ state.run;
+    for (size_t i = 0; i < _wordCount; ++i)
+    {
+        for (size_t p = 0; p <= PLANE_COUNT; ++p)
+        {
+            uint64_t word = p == 0 ? state.present[i] : state.planes[(p - 1) * _wordCount + i];
+            h ^= word + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            h ^= h >> 31;
+            h *= 0xBF58476D1CE4E5B9ull;
+        }
+    }
+    return h ^ (h >> 29);
+}
+
+template<size_t COLOR_COUNT>
+uint64_t BasicCompactGraph<COLOR_COUNT>::getGraphHash() const
+{
+    uint64_t h = hash(_initialState) ^ _maxCapacity;
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        for (const Edge &edge: getOutEdges(i))
+        {
+            uint64_t word = (uint64_t(i) << (32 + PLANE_COUNT)) | (uint64_t(edge.node) << PLANE_COUNT)
+                            | getColorCode(edge.color);
+            h ^= word + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+            h ^= h >> 31;
+            h *= 0xBF58476D1CE4E5B9ull;
+        }
+    }
+    return h ^ (h >> 29);
+}
+
+template<size_t COLOR_COUNT>
+size_t BasicCompactGraph<COLOR_COUNT>::stateBytes(const State &state)
+{
+    return sizeof(State) + (state.present.capacity() + state.planes.capacity()) * sizeof(uint64_t)
+           + state.sequence.capacity() * sizeof(uint32_t);
+}
+
+template class BasicCompactGraph<2>;
+template class BasicCompactGraph<3>;
+template class BasicCompactGraph<4>;
@@ -0,0 +1,124 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_COMPACTGRAPH_H
+#define RED_BLUE_GRAPH_SOLVER_1_COMPACTGRAPH_H
+
+#include <cstdint>
+#include <vector>
+#include "GraphInterface.h"
+
+class Graph;
+
+// Immutable CSR copy of a Graph whose colors are below COLOR_COUNT. The edges of a graph never change during a
+// search (only nodes disappear and get recolored), so a search state only needs bitsets: the nodes still present and
+// PLANE_COUNT planes holding the bits of the color of each present node. A plane holds the complement of its bit of
+// the color, an absent node having all its bits cleared: with two colors, the single plane is the set of the red
+// nodes.
+template<size_t COLOR_COUNT>
+class BasicCompactGraph
+{
+public:
+    static_assert(COLOR_COUNT >= 2 && COLOR_COUNT <= GraphInterface::MAX_COLOR_COUNT, "Unsupported color count");
+
+    static constexpr size_t PLANE_COUNT = COLOR_COUNT <= 2 ? 1 : 2;
+
+    struct State
+    {
+        std::vector<uint64_t> present;
+        // Word w of the plane p at p * wordCount + w
+        std::vector<uint64_t> planes;
+        size_t run = 0;
+        std::vector<uint32_t> sequence;
+    };
+
+    struct Edge
+    {
+        uint32_t node;
+        GraphInterface::Color color;
+    };
+
+    class EdgeRange
+    {
+    public:
+        EdgeRange(const Edge *begin, const Edge *end) : _begin(begin), _end(end)
+        {}
+
+        [[nodiscard]] const Edge *begin() const
+        {
+            return _begin;
+        }
+
+        [[nodiscard]] const Edge *end() const
+        {
+            return _end;
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return _end - _begin;
+        }
+
+    private:
+        const Edge *_begin;
+        const Edge *_end;
+    };
+
+    BasicCompactGraph() = delete;
+    explicit BasicCompactGraph(const Graph &graph);
+    // All the nodes are present. The out-edges of the node i are outEdges[outOffsets[i]] to
+    // outEdges[outOffsets[i + 1] - 1], sorted by strictly increasing target as in a Graph.
+    BasicCompactGraph(const std::vector<GraphInterface::Color> &colors, std::vector<size_t> outOffsets,
+                      std::vector<Edge> outEdges);
+    BasicCompactGraph(const BasicCompactGraph &otherGraph) = default;
+    BasicCompactGraph &operator=(const BasicCompactGraph &other) = default;
+    ~BasicCompactGraph() = default;
+
+    [[nodiscard]] size_t getMaxCapacity() const;
+
+    [[nodiscard]] size_t getWordCount() const;
+
+    [[nodiscard]] const State &getInitialState() const;
+
+    [[nodiscard]] EdgeRange getOutEdges(size_t id) const;
+
+    [[nodiscard]] EdgeRange getInEdges(size_t id) const;
+
+    [[nodiscard]] bool nodeExists(const State &state, size_t id) const;
+
+    [[nodiscard]] GraphInterface::Color getColor(const State &state, size_t id) const;
+
+    [[nodiscard]] size_t size(const State &state) const;
+
+    void removeNode(State &state, size_t id) const;
+
+    [[nodiscard]] uint64_t hash(const State &state) const;
+
+    // Hash of the nodes, colors and edges, equal for two graphs built the same way
+    [[nodiscard]] uint64_t getGraphHash() const;
+
+    [[nodiscard]] static size_t stateBytes(const State &state);
+
+private:
+    size_t _maxCapacity;
+    size_t _wordCount;
+    std::vector<size_t> _outOffsets;
+    std::vector<Edge> _outEdges;
+    std::vector<size_t> _inOffsets;
+    std::vector<Edge> _inEdges;
+    State _initialState;
+
+    static void checkColor(GraphInterface::Color color);
+
+    // Bits of the color as stored in the planes
+    [[nodiscard]] static uint64_t getColorCode(GraphInterface::Color color);
+
+    void setColor(State &state, size_t id, GraphInterface::Color color) const;
+
+    void buildInEdges();
+};
+
+extern template class BasicCompactGraph<2>;
+extern template class BasicCompactGraph<3>;
+extern template class BasicCompactGraph<4>;
+
+using CompactGraph = BasicCompactGraph<2>;
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_COMPACTGRAPH_H
@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include "CompactSequence.h"
+
+namespace
+{
+    constexpr size_t READ_CHUNK_SIZE = 1 << 16;
+
+    void writeVarint(std::vector<uint8_t> &bytes, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back(static_cast<uint8_t>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    bool readVarint(const std::vector<uint8_t> &bytes, size_t &offset, uint64_t &value)
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64 && offset < bytes.size(); shift += 7)
+        {
+            uint8_t byte = bytes[offset++];
+            value |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void writeVarint(std::ostream &os, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            os.put(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        os.put(static_cast<char>(value));
+    }
+
+    bool readVarint(std::istream &is, uint64_t &value)
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            int byte = is.get();
+            if (byte == std::char_traits<char>::eof())
+            {
+                return false;
+            }
+            value |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The first id of a range is written as its signed difference with the last id of the previous range, zigzagged
+    // so that a small step back is as short as a small step forward
+    void writeRange(std::vector<uint8_t> &bytes, size_t previousLast, size_t start, size_t length, bool descending)
+    {
+        int64_t delta = static_cast<int64_t>(start - previousLast);
+        writeVarint(bytes, static_cast<uint64_t>(delta) << 1 ^ static_cast<uint64_t>(delta >> 63));
+        writeVarint(bytes, (length - 1) << 1 | (descending ? 1 : 0));
+    }
+
+    bool readRange(const std::vector<uint8_t> &bytes, size_t &offset, size_t previousLast, size_t &start,
+                   size_t &length, bool &descending)
+    {
+        uint64_t delta, lengthAndDirection;
+        if (!readVarint(bytes, offset, delta) || !readVarint(bytes, offset, lengthAndDirection))
+        {
+            return false;
+        }
+        start = previousLast + static_cast<size_t>(delta >> 1 ^ (~(delta & 1) + 1));
+        length = (lengthAndDirection >> 1) + 1;
+        descending = lengthAndDirection & 1;
+        return true;
+    }
+}
+
+CompactSequence::Iterator::Iterator(const CompactSequence *sequence, size_t offset) : _sequence(sequence),
+                                                                                      _offset(offset)
+{
+}
+
+CompactSequence::Iterator &CompactSequence::Iterator::operator++()
+{
+    if (_remaining > 0)
+    {
+        _descending ? _id-- : _id++;
+        _remaining--;
+    } else
+    {
+        loadRange();
+    }
+    return *this;
+}
+
+CompactSequence::Iterator CompactSequence::Iterator::operator++(int)
+{
+    Iterator previous(*this);
+    ++*this;
+    return previous;
+}
+
+void CompactSequence::Iterator::loadRange()
+{
+    const std::vector<uint8_t> &bytes = _sequence->_bytes;
+    size_t length = 0;
+    if (_offset < bytes.size())
+    {
+        // _id is the last id of the previous range, 0 before the first one as when it was written. The bytes are
+        // only written by the sequence, a range that cannot be read ends it all the same.
+        if (!readRange(bytes, _offset, _id, _id, length, _descending))
+        {
+            *this = _sequence->end();
+            return;
+        }
+    } else if (_offset == bytes.size() && _sequence->_lastLength > 0)
+    {
+        _id = _sequence->_lastStart;
+        length = _sequence->_lastLength;
+        _descending = _sequence->_lastDescending;
+        _offset++;
+    } else
+    {
+        *this = _sequence->end();
+        return;
+    }
+    _remaining = length - 1;
+}
+
+CompactSequence::CompactSequence(const std::deque<size_t> &sequence)
+{
+    for (size_t id: sequence)
+    {
+        append(id);
+    }
+}
+
+void CompactSequence::append(size_t id)
+{
+    if (_lastLength == 1 && (id == _lastStart + 1 || id + 1 == _lastStart))
+    {
+        _lastDescending = id + 1 == _lastStart;
+    } else if (_lastLength == 0 || _lastLength == 1 || id != (_lastDescending ? getLastEnd() - 1 : getLastEnd() + 1))
+    {
+        if (_lastLength > 0)
+        {
+            writeLastRange();
+        }
+        _lastStart = id;
+        _lastLength = 0;
+        _lastDescending = false;
+    }
+    _lastLength++;
+    _size++;
+}
+
+CompactSequence::Iterator CompactSequence::begin() const
+{
+    Iterator iterator(this, 0);
+    iterator.loadRange();
+    return iterator;
+}
+
+CompactSequence::Iterator CompactSequence::end() const
+{
+    return Iterator(this, _bytes.size() + 2);
+}
+
+size_t CompactSequence::size() const
+{
+    return _size;
+}
+
+bool CompactSequence::isEmpty() const
+{
+    return _size == 0;
+}
+
+size_t CompactSequence::getRangeCount() const
+{
+    return _rangeCount + (_lastLength > 0 ? 1 : 0);
+}
+
+std::deque<size_t> CompactSequence::toDeque() const
+{
+    return std::deque<size_t>(begin(), end());
+}
+
+size_t CompactSequence::getMemoryUsage() const
+{
+    return sizeof(CompactSequence) + _bytes.size();
+}
+
+void CompactSequence::write(std::ostream &os) const
+{
+    std::vector<uint8_t> bytes(_bytes);
+    if (_lastLength > 0)
+    {
+        writeRange(bytes, _writtenLast, _lastStart, _lastLength, _lastDescending);
+    }
+    writeVarint(os, _size);
+    writeVarint(os, getRangeCount());
+    writeVarint(os, bytes.size());
+    os.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+CompactSequence CompactSequence::read(std::istream &is)
+{
+    uint64_t size, rangeCount, byteCount;
+    if (!readVarint(is, size) || !readVarint(is, rangeCount) || !readVarint(is, byteCount))
+    {
+        throw std::runtime_error("Invalid compact sequence");
+    }
+    // Read by chunks, so that a corrupt count runs into the end of the stream instead of allocating it first
+    std::vector<uint8_t> bytes;
+    while (bytes.size() < byteCount)
+    {
+        size_t chunkSize = static_cast<size_t>(std::min<uint64_t>(byteCount - bytes.size(), READ_CHUNK_SIZE));
+        bytes.resize(bytes.size() + chunkSize);
+        if (!is.read(reinterpret_cast<char *>(bytes.data() + bytes.size() - chunkSize),
+                     static_cast<std::streamsize>(chunkSize)))
+        {
+            throw std::runtime_error("Invalid compact sequence");
+        }
+    }
+    // The last range is taken back out of the bytes so that ids can be appended to it
+    CompactSequence sequence;
+    size_t offset = 0;
+    size_t lastOffset = 0;
+    size_t total = 0;
+    for (uint64_t i = 0; i < rangeCount; ++i)
+    {
+        if (i > 0)
+        {
+            sequence._writtenLast = sequence.getLastEnd();
+        }
+        lastOffset = offset;
+        if (!readRange(bytes, offset, sequence._writtenLast, sequence._lastStart, sequence._lastLength,
+                       sequence._lastDescending))
+        {
+            throw std::runtime_error("Invalid compact sequence");
+        }
+        total += sequence._lastLength;
+    }
+    if (offset != bytes.size() || total != size)
+    {
+        throw std::runtime_error("Invalid compact sequence");
+    }
+    bytes.resize(lastOffset);
+    sequence._bytes = std::move(bytes);
+    sequence._size = size;
+    sequence._rangeCount = rangeCount > 0 ? rangeCount - 1 : 0;
+    return sequence;
+}
+
+size_t CompactSequence::getLastEnd() const
+{
+    return _lastDescending ? _lastStart - (_lastLength - 1) : _lastStart + (_lastLength - 1);
+}
+
+void CompactSequence::writeLastRange()
+{
+    writeRange(_bytes, _writtenLast, _lastStart, _lastLength, _lastDescending);
+    _writtenLast = getLastEnd();
+    _rangeCount++;
+}
+
+bool operator==(const CompactSequence &s1, const CompactSequence &s2)
+{
+    // The ranges only depend on the ids, each one being extended as long as possible
+    return s1._size == s2._size && s1._bytes == s2._bytes && s1._lastStart == s2._lastStart
+           && s1._lastLength == s2._lastLength && s1._lastDescending == s2._lastDescending;
+}
@@ -0,0 +1,108 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_COMPACTSEQUENCE_H
+#define RED_BLUE_GRAPH_SOLVER_1_COMPACTSEQUENCE_H
+
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <iterator>
+#include <vector>
+
+// Removal sequence stored as ranges of consecutive ids, each going up or down by one. The sweeps of FlatGraph remove
+// long increasing ranges broken by short decreasing ones, so a range is written with two varints: its first id as the
+// difference with the last id of the previous range and its length with its direction. The last range is kept apart
+// until the next id does not extend it, so an id is appended in constant time, and the sequence is read forward only.
+class CompactSequence
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t *;
+        using reference = const size_t &;
+
+        [[nodiscard]] const size_t &operator*() const
+        {
+            return _id;
+        }
+
+        Iterator &operator++();
+
+        Iterator operator++(int);
+
+        friend bool operator==(const Iterator &i1, const Iterator &i2)
+        {
+            return i1._sequence == i2._sequence && i1._offset == i2._offset && i1._remaining == i2._remaining;
+        }
+
+        friend bool operator!=(const Iterator &i1, const Iterator &i2)
+        {
+            return !(i1 == i2);
+        }
+
+    private:
+        friend class CompactSequence;
+
+        Iterator(const CompactSequence *sequence, size_t offset);
+
+        const CompactSequence *_sequence;
+        // Offset in the bytes of the next range, one past them for the last range
+        size_t _offset;
+        size_t _id = 0;
+        // Ids of the current range after this one
+        size_t _remaining = 0;
+        bool _descending = false;
+
+        void loadRange();
+    };
+
+    CompactSequence() = default;
+    explicit CompactSequence(const std::deque<size_t> &sequence);
+    CompactSequence(const CompactSequence &otherSequence) = default;
+    CompactSequence(CompactSequence &&otherSequence) noexcept = default;
+    CompactSequence &operator=(const CompactSequence &other) = default;
+    CompactSequence &operator=(CompactSequence &&other) noexcept = default;
+    ~CompactSequence() = default;
+
+    void append(size_t id);
+
+    [[nodiscard]] Iterator begin() const;
+
+    [[nodiscard]] Iterator end() const;
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] bool isEmpty() const;
+
+    [[nodiscard]] size_t getRangeCount() const;
+
+    [[nodiscard]] std::deque<size_t> toDeque() const;
+
+    // Bytes held by the sequence, itself included
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+    // The ranges as they are stored, after their count
+    void write(std::ostream &os) const;
+
+    [[nodiscard]] static CompactSequence read(std::istream &is);
+
+    friend bool operator==(const CompactSequence &s1, const CompactSequence &s2);
+
+private:
+    std::vector<uint8_t> _bytes;
+    size_t _size = 0;
+    size_t _rangeCount = 0;
+    // Last id of the ranges written in the bytes
+    size_t _writtenLast = 0;
+    size_t _lastStart = 0;
+    size_t _lastLength = 0;
+    bool _lastDescending = false;
+
+    [[nodiscard]] size_t getLastEnd() const;
+
+    void writeLastRange();
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_COMPACTSEQUENCE_H
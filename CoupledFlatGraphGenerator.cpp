@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <numeric>
+#include "CoupledFlatGraphGenerator.h"
+
+CoupledFlatGraphGenerator::CoupledFlatGraphGenerator(uint64_t seed) : _randomGenerator(seed), _distribution(0, 1)
+{}
+
+void CoupledFlatGraphGenerator::draw(FlatGraph &graph, double redNodeProbability, double redEdgeProbability,
+                                     double leftDirectedEdgeProbability)
+{
+    _nodeUniforms.resize(graph._nodes.size());
+    for (size_t i = 0; i < graph._nodes.size(); ++i)
+    {
+        _nodeUniforms[i] = _distribution(_randomGenerator);
+        graph._nodes[i] = FlatGraph::FlatGraphNode{_nodeUniforms[i] < redNodeProbability ? GraphInterface::Color::RED
+                                                                                         : GraphInterface::Color::BLUE};
+    }
+    _edgeUniforms.resize(graph._edges.size());
+    for (size_t i = 0; i < graph._edges.size(); ++i)
+    {
+        _edgeUniforms[i] = _distribution(_randomGenerator);
+        FlatGraph::FlatGraphEdge flatGraphEdge{};
+        flatGraphEdge.color = _edgeUniforms[i] < redEdgeProbability ? GraphInterface::Color::RED
+                                                                    : GraphInterface::Color::BLUE;
+        flatGraphEdge.isLeft = _distribution(_randomGenerator) < leftDirectedEdgeProbability;
+        graph._edges[i] = flatGraphEdge;
+    }
+    graph._size = graph._maxCapacity;
+    _redNodeProbability = redNodeProbability;
+    _redEdgeProbability = redEdgeProbability;
+
+    for (auto[uniforms, order]: {std::make_pair(&_nodeUniforms, &_nodeOrder),
+                                 std::make_pair(&_edgeUniforms, &_edgeOrder)})
+    {
+        order->resize(uniforms->size());
+        std::iota(order->begin(), order->end(), 0);
+        std::sort(order->begin(), order->end(), [uniforms = uniforms](uint32_t id1, uint32_t id2)
+        {
+            return (*uniforms)[id1] < (*uniforms)[id2];
+        });
+    }
+}
+
+size_t CoupledFlatGraphGenerator::update(FlatGraph &graph, double redNodeProbability, double redEdgeProbability)
+{
+    size_t recolored = recolorBetween(_nodeUniforms, _nodeOrder, _redNodeProbability, redNodeProbability,
+                                      [&graph](uint32_t id, GraphInterface::Color color)
+                                      {
+                                          graph._nodes[id]->color = color;
+                                      });
+    recolored += recolorBetween(_edgeUniforms, _edgeOrder, _redEdgeProbability, redEdgeProbability,
+                                [&graph](uint32_t id, GraphInterface::Color color)
+                                {
+                                    graph._edges[id]->color = color;
+                                });
+    _redNodeProbability = redNodeProbability;
+    _redEdgeProbability = redEdgeProbability;
+    return recolored;
+}
+
+template<typename Recolor>
+size_t CoupledFlatGraphGenerator::recolorBetween(const std::vector<float> &uniforms, const std::vector<uint32_t> &order,
+                                                 double from, double to, const Recolor &recolor)
+{
+    auto byUniform = [&uniforms](uint32_t id, double probability)
+    {
+        return uniforms[id] < probability;
+    };
+    auto first = std::lower_bound(order.begin(), order.end(), std::min(from, to), byUniform);
+    auto last = std::lower_bound(first, order.end(), std::max(from, to), byUniform);
+    GraphInterface::Color color = to > from ? GraphInterface::Color::RED : GraphInterface::Color::BLUE;
+    for (auto it = first; it != last; ++it)
+    {
+        recolor(*it, color);
+    }
+    return last - first;
+}
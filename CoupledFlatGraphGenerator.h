@@ -0,0 +1,44 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_COUPLEDFLATGRAPHGENERATOR_H
+#define RED_BLUE_GRAPH_SOLVER_1_COUPLEDFLATGRAPHGENERATOR_H
+
+#include <random>
+#include <vector>
+#include "FlatGraph.h"
+
+// Random complete FlatGraphs for common random numbers: a draw keeps one uniform per node color, edge color and edge
+// direction, and the graph of any probabilities is the one whose nodes and edges are red when their uniform is below
+// the probability. All the cells of a sweep then share one draw, and moving the graph to other probabilities only
+// rewrites the nodes and edges whose uniform lies between the old and the new probability.
+class CoupledFlatGraphGenerator
+{
+public:
+    CoupledFlatGraphGenerator() = delete;
+    explicit CoupledFlatGraphGenerator(uint64_t seed);
+    CoupledFlatGraphGenerator(const CoupledFlatGraphGenerator &otherGenerator) = default;
+    ~CoupledFlatGraphGenerator() = default;
+
+    // New uniforms for every node and edge of the graph, which is overwritten with the given probabilities
+    void draw(FlatGraph &graph, double redNodeProbability = 0.5, double redEdgeProbability = 0.5,
+              double leftDirectedEdgeProbability = 0.5);
+
+    // Recolors the graph of the last draw for other probabilities, returning the number of nodes and edges recolored
+    size_t update(FlatGraph &graph, double redNodeProbability, double redEdgeProbability);
+
+private:
+    std::mt19937_64 _randomGenerator;
+    std::uniform_real_distribution<float> _distribution;
+    std::vector<float> _nodeUniforms;
+    std::vector<float> _edgeUniforms;
+    // Ids sorted by uniform, the ones recolored by an update being contiguous
+    std::vector<uint32_t> _nodeOrder;
+    std::vector<uint32_t> _edgeOrder;
+    double _redNodeProbability = 0;
+    double _redEdgeProbability = 0;
+
+    // Ids of order whose uniform is in [min(from, to), max(from, to)), given to recolor with the color of to
+    template<typename Recolor>
+    static size_t recolorBetween(const std::vector<float> &uniforms, const std::vector<uint32_t> &order, double from,
+                                 double to, const Recolor &recolor);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_COUPLEDFLATGRAPHGENERATOR_H
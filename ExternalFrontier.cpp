@@ -0,0 +1,477 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <queue>
+#include <string>
+#include "ExternalFrontier.h"
+
+namespace
+{
+    void writeVarint(std::ostream &os, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            os.put(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        os.put(static_cast<char>(value));
+    }
+
+    bool readVarint(std::istream &is, uint64_t &value)
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            int byte = is.get();
+            if (byte == std::char_traits<char>::eof())
+            {
+                return false;
+            }
+            value |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr size_t RUN_IO_BUFFER_SIZE = 1 << 16;
+    // Runs read at once by a merge, so that a layer spilled many times does not open a file per run
+    constexpr size_t MERGE_FAN_IN = 16;
+    // States kept in memory before a spill, so that a budget taken by the merge buffers does not write a run per push
+    constexpr size_t MIN_SPILL_BYTES = RUN_IO_BUFFER_SIZE;
+}
+
+// Records of a run are sorted by hash: the hash is stored as a delta to the previous record, the bitsets as a xor
+// with the previous record and the removal sequence as plain varints. A state equal to the previous one is skipped.
+class ExternalFrontier::RunWriter
+{
+public:
+    RunWriter(const std::filesystem::path &path, size_t wordCount) : _path(path), _buffer(RUN_IO_BUFFER_SIZE),
+                                                                     _previousPresent(wordCount, 0),
+                                                                     _previousPlanes(wordCount, 0)
+    {
+        _stream.rdbuf()->pubsetbuf(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _stream.open(path, std::ios::binary | std::ios::trunc);
+        if (!_stream)
+        {
+            throw std::runtime_error("Cannot create frontier run " + path.string());
+        }
+    }
+
+    // False when the record is a duplicate of the previous one
+    bool write(const Record &record)
+    {
+        if (_hasPrevious && record.hash == _previousHash && record.state.present == _previousPresent
+            && record.state.planes == _previousPlanes)
+        {
+            return false;
+        }
+        writeVarint(_stream, record.hash - _previousHash);
+        for (size_t i = 0; i < _previousPresent.size(); ++i)
+        {
+            writeVarint(_stream, record.state.present[i] ^ _previousPresent[i]);
+            writeVarint(_stream, record.state.planes[i] ^ _previousPlanes[i]);
+        }
+        writeVarint(_stream, record.state.sequence.size());
+        for (uint32_t id: record.state.sequence)
+        {
+            writeVarint(_stream, id);
+        }
+        _hasPrevious = true;
+        _previousHash = record.hash;
+        _previousPresent = record.state.present;
+        _previousPlanes = record.state.planes;
+        return true;
+    }
+
+    void close()
+    {
+        _stream.close();
+        if (!_stream)
+        {
+            throw std::runtime_error("Cannot write frontier run " + _path.string());
+        }
+    }
+
+private:
+    std::filesystem::path _path;
+    std::vector<char> _buffer;
+    std::ofstream _stream;
+    bool _hasPrevious = false;
+    uint64_t _previousHash = 0;
+    std::vector<uint64_t> _previousPresent;
+    std::vector<uint64_t> _previousPlanes;
+};
+
+class ExternalFrontier::RunReader
+{
+public:
+    RunReader(const std::filesystem::path &path, size_t wordCount, size_t run) : _path(path),
+                                                                                 _buffer(RUN_IO_BUFFER_SIZE),
+                                                                                 _previousPresent(wordCount, 0),
+                                                                                 _previousPlanes(wordCount, 0),
+                                                                                 _run(run)
+    {
+        _stream.rdbuf()->pubsetbuf(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _stream.open(path, std::ios::binary);
+        if (!_stream)
+        {
+            throw std::runtime_error("Cannot open frontier run " + path.string());
+        }
+        advance();
+    }
+
+    [[nodiscard]] bool hasCurrent() const
+    {
+        return _current.has_value();
+    }
+
+    [[nodiscard]] const Record &current() const
+    {
+        return *_current;
+    }
+
+    Record takeCurrent()
+    {
+        Record record = std::move(*_current);
+        advance();
+        return record;
+    }
+
+private:
+    void advance()
+    {
+        _current.reset();
+        if (_stream.peek() == std::char_traits<char>::eof())
+        {
+            return;
+        }
+        uint64_t hashDelta, sequenceLength, value;
+        read(hashDelta);
+        Record record{_previousHash + hashDelta, CompactGraph::State()};
+        record.state.run = _run;
+        record.state.present.resize(_previousPresent.size());
+        record.state.planes.resize(_previousPlanes.size());
+        for (size_t i = 0; i < _previousPresent.size(); ++i)
+        {
+            read(value);
+            _previousPresent[i] ^= value;
+            record.state.present[i] = _previousPresent[i];
+            read(value);
+            _previousPlanes[i] ^= value;
+            record.state.planes[i] = _previousPlanes[i];
+        }
+        read(sequenceLength);
+        // A sequence is never longer than the states it went through, a larger length is a corrupt run
+        if (sequenceLength > _previousPresent.size() * 64)
+        {
+            throw std::runtime_error("Invalid frontier run " + _path.string());
+        }
+        record.state.sequence.resize(sequenceLength);
+        for (uint32_t &id: record.state.sequence)
+        {
+            read(value);
+            id = static_cast<uint32_t>(value);
+        }
+        _previousHash = record.hash;
+        _current = std::move(record);
+    }
+
+    // Only the end of the file between two records ends the run, anywhere else it is truncated
+    void read(uint64_t &value)
+    {
+        if (!readVarint(_stream, value))
+        {
+            throw std::runtime_error("Truncated frontier run " + _path.string());
+        }
+    }
+
+    std::filesystem::path _path;
+    std::vector<char> _buffer;
+    std::ifstream _stream;
+    uint64_t _previousHash = 0;
+    std::vector<uint64_t> _previousPresent;
+    std::vector<uint64_t> _previousPlanes;
+    size_t _run;
+    std::optional<Record> _current;
+};
+
+class ExternalFrontier::RunMerger
+{
+public:
+    // The buffers of the readers and the records held are charged to memoryUsage while the merger lives
+    RunMerger(std::vector<std::filesystem::path> &&runs, size_t wordCount, size_t run, size_t &duplicateCount,
+              size_t &memoryUsage) : _runs(std::move(runs)), _duplicateCount(duplicateCount),
+                                     _memoryUsage(memoryUsage),
+                                     _readerBytes(_runs.size() * (sizeof(RunReader) + RUN_IO_BUFFER_SIZE
+                                                                  + 2 * wordCount * sizeof(uint64_t)))
+    {
+        charge();
+        for (const std::filesystem::path &path: _runs)
+        {
+            _readers.push_back(std::make_unique<RunReader>(path, wordCount, run));
+            if (_readers.back()->hasCurrent())
+            {
+                _heap.push(_readers.size() - 1);
+            }
+        }
+        prefetch();
+    }
+
+    ~RunMerger()
+    {
+        _memoryUsage -= _charge;
+        _readers.clear();
+        std::error_code errorCode;
+        for (const std::filesystem::path &path: _runs)
+        {
+            std::filesystem::remove(path, errorCode);
+        }
+    }
+
+    [[nodiscard]] bool hasNext() const
+    {
+        return _next.has_value();
+    }
+
+    Record next()
+    {
+        Record record = std::move(*_next);
+        prefetch();
+        return record;
+    }
+
+private:
+    struct ReaderGreater
+    {
+        const RunMerger *merger;
+
+        bool operator()(size_t r1, size_t r2) const
+        {
+            return recordLess(merger->_readers[r2]->current(), merger->_readers[r1]->current());
+        }
+    };
+
+    void prefetch()
+    {
+        _next.reset();
+        while (!_heap.empty())
+        {
+            size_t reader = _heap.top();
+            _heap.pop();
+            Record record = _readers[reader]->takeCurrent();
+            if (_readers[reader]->hasCurrent())
+            {
+                _heap.push(reader);
+            }
+            if (_last.has_value() && sameState(*_last, record))
+            {
+                _duplicateCount++;
+                continue;
+            }
+            _last = Record{record.hash, CompactGraph::State{record.state.present, record.state.planes, record.state.run, {}}};
+            _next = std::move(record);
+            break;
+        }
+        charge();
+    }
+
+    void charge()
+    {
+        size_t bytes = _readerBytes + (_last.has_value() ? CompactGraph::stateBytes(_last->state) : 0)
+                       + (_next.has_value() ? CompactGraph::stateBytes(_next->state) : 0);
+        _memoryUsage = _memoryUsage - _charge + bytes;
+        _charge = bytes;
+    }
+
+    std::vector<std::filesystem::path> _runs;
+    std::vector<std::unique_ptr<RunReader>> _readers;
+    std::priority_queue<size_t, std::vector<size_t>, ReaderGreater> _heap{ReaderGreater{this}};
+    std::optional<Record> _last;
+    std::optional<Record> _next;
+    size_t &_duplicateCount;
+    size_t &_memoryUsage;
+    size_t _readerBytes;
+    size_t _charge = 0;
+};
+
+ExternalFrontier::ExternalFrontier(const CompactGraph &graph, size_t memoryBudget,
+                                   const std::filesystem::path &spillDirectory) : _graph(graph),
+                                                                                  _memoryBudget(memoryBudget)
+{
+    static std::atomic<size_t> frontierCounter(0);
+    _directory = spillDirectory / ("red_blue_frontier_"
+                                   + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())
+                                   + "_" + std::to_string(frontierCounter++));
+    _layers.resize(graph.getMaxCapacity() + 1);
+}
+
+ExternalFrontier::~ExternalFrontier()
+{
+    _layers.clear();
+    std::error_code errorCode;
+    std::filesystem::remove_all(_directory, errorCode);
+}
+
+void ExternalFrontier::push(CompactGraph::State &&state)
+{
+    size_t run = state.run;
+    if (run >= _layers.size())
+    {
+        throw std::out_of_range("Run length is larger than the graph");
+    }
+    size_t bytes = CompactGraph::stateBytes(state);
+    _memoryUsage += bytes;
+    _bufferedBytes += bytes;
+    _layers[run].buffer.push_back(Record{_graph.hash(state), std::move(state)});
+    if (_memoryUsage > _memoryBudget && _bufferedBytes >= MIN_SPILL_BYTES)
+    {
+        spillAll();
+    }
+}
+
+std::optional<CompactGraph::State> ExternalFrontier::pop()
+{
+    for (size_t run = _layers.size(); run-- > 0;)
+    {
+        Layer &layer = _layers[run];
+        while (layerHasStates(layer))
+        {
+            if (layer.merger && layer.merger->hasNext())
+            {
+                // The merger is released with its last state, its buffers no longer counting in the memory used
+                Record record = layer.merger->next();
+                if (!layer.merger->hasNext())
+                {
+                    layer.merger.reset();
+                }
+                return std::move(record.state);
+            }
+            layer.merger.reset();
+            if (!layer.runs.empty())
+            {
+                spillLayer(run);
+                while (layer.runs.size() > MERGE_FAN_IN)
+                {
+                    mergeRuns(run);
+                }
+                layer.merger = std::make_unique<RunMerger>(std::move(layer.runs), _graph.getWordCount(), run,
+                                                           _duplicateCount, _memoryUsage);
+                layer.runs.clear();
+                continue;
+            }
+            Record record = std::move(layer.buffer.back());
+            layer.buffer.pop_back();
+            _memoryUsage -= CompactGraph::stateBytes(record.state);
+            _bufferedBytes -= CompactGraph::stateBytes(record.state);
+            return std::move(record.state);
+        }
+    }
+    return std::nullopt;
+}
+
+bool ExternalFrontier::isEmpty() const
+{
+    return std::none_of(_layers.begin(), _layers.end(), [this](const Layer &layer) {
+        return layerHasStates(layer);
+    });
+}
+
+size_t ExternalFrontier::getMemoryUsage() const
+{
+    return _memoryUsage;
+}
+
+size_t ExternalFrontier::getSpilledRunCount() const
+{
+    return _spilledRunCount;
+}
+
+size_t ExternalFrontier::getDuplicateCount() const
+{
+    return _duplicateCount;
+}
+
+bool ExternalFrontier::recordLess(const Record &r1, const Record &r2)
+{
+    if (r1.hash != r2.hash)
+    {
+        return r1.hash < r2.hash;
+    }
+    if (r1.state.present != r2.state.present)
+    {
+        return r1.state.present < r2.state.present;
+    }
+    return r1.state.planes < r2.state.planes;
+}
+
+bool ExternalFrontier::sameState(const Record &r1, const Record &r2)
+{
+    return r1.hash == r2.hash && r1.state.present == r2.state.present && r1.state.planes == r2.state.planes;
+}
+
+bool ExternalFrontier::layerHasStates(const Layer &layer) const
+{
+    return !layer.buffer.empty() || !layer.runs.empty() || (layer.merger && layer.merger->hasNext());
+}
+
+void ExternalFrontier::spillLayer(size_t run)
+{
+    Layer &layer = _layers[run];
+    if (layer.buffer.empty())
+    {
+        return;
+    }
+    std::sort(layer.buffer.begin(), layer.buffer.end(), recordLess);
+    std::filesystem::path path = getRunPath(run);
+    RunWriter writer(path, _graph.getWordCount());
+    for (const Record &record: layer.buffer)
+    {
+        _memoryUsage -= CompactGraph::stateBytes(record.state);
+        _bufferedBytes -= CompactGraph::stateBytes(record.state);
+        if (!writer.write(record))
+        {
+            _duplicateCount++;
+        }
+    }
+    writer.close();
+    layer.buffer.clear();
+    layer.buffer.shrink_to_fit();
+    layer.runs.push_back(path);
+    _spilledRunCount++;
+}
+
+void ExternalFrontier::mergeRuns(size_t run)
+{
+    Layer &layer = _layers[run];
+    std::vector<std::filesystem::path> runs(layer.runs.begin(), layer.runs.begin() + MERGE_FAN_IN);
+    layer.runs.erase(layer.runs.begin(), layer.runs.begin() + MERGE_FAN_IN);
+    std::filesystem::path path = getRunPath(run);
+    {
+        RunMerger merger(std::move(runs), _graph.getWordCount(), run, _duplicateCount, _memoryUsage);
+        RunWriter writer(path, _graph.getWordCount());
+        while (merger.hasNext())
+        {
+            writer.write(merger.next());
+        }
+        writer.close();
+    }
+    layer.runs.push_back(path);
+}
+
+std::filesystem::path ExternalFrontier::getRunPath(size_t run)
+{
+    std::filesystem::create_directories(_directory);
+    return _directory / ("layer_" + std::to_string(run) + "_run_" + std::to_string(_runFileCount++) + ".bin");
+}
+
+void ExternalFrontier::spillAll()
+{
+    for (size_t run = 0; run < _layers.size(); ++run)
+    {
+        spillLayer(run);
+    }
+}
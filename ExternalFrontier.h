@@ -0,0 +1,83 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_EXTERNALFRONTIER_H
+#define RED_BLUE_GRAPH_SOLVER_1_EXTERNALFRONTIER_H
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "CompactGraph.h"
+
+// Best-first frontier whose layers (one per run length) are spilled to disk as sorted, varint encoded runs once
+// the memory used exceeds the memory budget and at least one batch of states is in memory. A layer stored on disk is
+// streamed back through a k-way merge, in several passes when it has many runs, which drops the states already seen
+// in another run (same hash and same bitsets). The buffers of the merges count in the memory used. States pushed
+// into a layer while its merge is under way are merged on their own later, so they may repeat a state already popped.
+class ExternalFrontier
+{
+public:
+    ExternalFrontier() = delete;
+    ExternalFrontier(const CompactGraph &graph, size_t memoryBudget, const std::filesystem::path &spillDirectory);
+    ExternalFrontier(const ExternalFrontier &) = delete;
+    ExternalFrontier &operator=(const ExternalFrontier &) = delete;
+    ~ExternalFrontier();
+
+    void push(CompactGraph::State &&state);
+
+    [[nodiscard]] std::optional<CompactGraph::State> pop();
+
+    [[nodiscard]] bool isEmpty() const;
+
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+    [[nodiscard]] size_t getSpilledRunCount() const;
+
+    [[nodiscard]] size_t getDuplicateCount() const;
+
+private:
+    struct Record
+    {
+        uint64_t hash;
+        CompactGraph::State state;
+    };
+
+    class RunWriter;
+
+    class RunReader;
+
+    class RunMerger;
+
+    struct Layer
+    {
+        std::vector<Record> buffer;
+        std::vector<std::filesystem::path> runs;
+        std::unique_ptr<RunMerger> merger;
+    };
+
+    const CompactGraph &_graph;
+    size_t _memoryBudget;
+    size_t _memoryUsage = 0;
+    // Part of the memory used by the states of the layer buffers
+    size_t _bufferedBytes = 0;
+    size_t _spilledRunCount = 0;
+    size_t _runFileCount = 0;
+    size_t _duplicateCount = 0;
+    std::filesystem::path _directory;
+    std::vector<Layer> _layers;
+
+    static bool recordLess(const Record &r1, const Record &r2);
+
+    static bool sameState(const Record &r1, const Record &r2);
+
+    [[nodiscard]] bool layerHasStates(const Layer &layer) const;
+
+    void spillLayer(size_t run);
+
+    void spillAll();
+
+    // Merges the first runs of the layer into one run
+    void mergeRuns(size_t run);
+
+    [[nodiscard]] std::filesystem::path getRunPath(size_t run);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_EXTERNALFRONTIER_H
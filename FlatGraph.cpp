@@ -1,5 +1,4 @@
 #include <iostream>
-#include <chrono>
 #include <list>
 #include "FlatGraph.h"
 
@@ -7,9 +6,6 @@ FlatGraph::FlatGraph(size_t maxCapacity) : _maxCapacity(maxCapacity)
 {
     _nodes.resize(maxCapacity);
     _edges.resize(maxCapacity - 1);
-    size_t randomNumberGeneratorSeed = static_cast<size_t>(std::chrono::system_clock::now().time_since_epoch().count());
-    _randomGenerator.seed(randomNumberGeneratorSeed);
-    _randomEngine.seed(_randomGenerator());
 }
 
 void FlatGraph::removeNode(size_t nodeId)
@@ -35,47 +31,6 @@ void FlatGraph::removeNode(size_t nodeId)
     _size--;
 }
 
-void FlatGraph::generateRandom(double redNodeProbability, double redEdgeProbability, double leftDirectedEdgeProbability)
-{
-    std::uniform_real_distribution<float> distr(0, 1);
-    std::transform(_nodes.begin(), _nodes.end(), _nodes.begin(),
-                   [this, &redNodeProbability, &distr](std::optional<FlatGraphNode> node) {
-                       FlatGraphNode flatGraphNode{};
-                       double randomNumber = distr(_randomEngine);
-                       if (randomNumber < redNodeProbability)
-                       {
-                           flatGraphNode.color = GraphInterface::Color::RED;
-                       } else
-                       {
-                           flatGraphNode.color = GraphInterface::Color::BLUE;
-                       }
-                       return flatGraphNode;
-                   });
-    std::transform(_edges.begin(), _edges.end(), _edges.begin(),
-                   [this, &redEdgeProbability, &leftDirectedEdgeProbability, &distr](
-                           std::optional<FlatGraphEdge> edge) {
-                       FlatGraphEdge flatGraphEdge{};
-                       double randomNumber = distr(_randomEngine);
-                       if (randomNumber < redEdgeProbability)
-                       {
-                           flatGraphEdge.color = GraphInterface::Color::RED;
-                       } else
-                       {
-                           flatGraphEdge.color = GraphInterface::Color::BLUE;
-                       }
-                       randomNumber = distr(_randomEngine);
-                       if (randomNumber < leftDirectedEdgeProbability)
-                       {
-                           flatGraphEdge.isLeft = true;
-                       } else
-                       {
-                           flatGraphEdge.isLeft = false;
-                       }
-                       return flatGraphEdge;
-                   });
-    _size = _maxCapacity;
-}
-
 std::ostream &operator<<(std::ostream &os, const FlatGraph &graph)
 {
     for (size_t i = 0; i < graph._maxCapacity; i++)
@@ -85,7 +40,7 @@ std::ostream &operator<<(std::ostream &os, const FlatGraph &graph)
             if (graph._edges[i - 1].has_value())
             {
                 const FlatGraph::FlatGraphEdge &edge = graph._edges[i - 1].value();
-                std::string edgeColor = (edge.color == GraphInterface::Color::RED ? "RED" : "BLUE");
+                std::string edgeColor = GraphInterface::getColorName(edge.color);
                 if (edge.isLeft)
                 {
                     os << "<-" << edgeColor << "-";
@@ -100,7 +55,7 @@ std::ostream &operator<<(std::ostream &os, const FlatGraph &graph)
         }
         if (graph._nodes[i].has_value())
         {
-            os << "[" << (graph._nodes[i].value().color == GraphInterface::Color::RED ? "RED" : "BLUE") << "]";
+            os << "[" << GraphInterface::getColorName(graph._nodes[i].value().color) << "]";
         } else
         {
             os << "   ";
@@ -139,7 +94,7 @@ std::vector<std::pair<GraphInterface::Color, size_t>> FlatGraph::getNodeNeighbor
 
 void FlatGraph::createNode(const GraphInterface::Color &color, size_t id)
 {
-    if (id > _maxCapacity)
+    if (id >= _maxCapacity)
     {
         throw GraphInterface::GraphModificationException("Node id is too big.");
     }
@@ -175,18 +130,30 @@ size_t FlatGraph::getMaxCapacity() const
     return _maxCapacity;
 }
 
-bool FlatGraph::isColor(size_t nodeId, size_t edgeId, const GraphInterface::Color &color/*, bool leftOrRight*/) const
+bool FlatGraph::nodeExists(const SweepState &state, size_t id) const
+{
+    return id < _maxCapacity && state.nodes[id].has_value();
+}
+
+bool FlatGraph::edgeExists(const SweepState &state, size_t id) const
 {
-    return this->nodeExists(nodeId)
-           && this->_nodes[nodeId]->color == color
-           && this->edgeExists(edgeId)
+    return edgeExists(id) && state.nodes[id].has_value() && state.nodes[id + 1].has_value();
+}
+
+bool FlatGraph::isColor(const SweepState &state, size_t nodeId, size_t edgeId,
+                        const GraphInterface::Color &color) const
+{
+    return nodeExists(state, nodeId)
+           && state.nodes[nodeId]->color == color
+           && edgeExists(state, edgeId)
            && _edges[edgeId]->color == color;
 }
 
-bool FlatGraph::mayBeInterestingToRemove(size_t nodeId, const GraphInterface::Color &color, bool leftOrRight) const
+bool FlatGraph::mayBeInterestingToRemove(const SweepState &state, size_t nodeId, const GraphInterface::Color &color,
+                                         bool leftOrRight) const
 {
     size_t edgeId = leftOrRight ? nodeId - 1 : nodeId;
-    if (!this->edgeExists(edgeId))
+    if (!edgeExists(state, edgeId))
     {
         return false;
     }
@@ -195,8 +162,8 @@ bool FlatGraph::mayBeInterestingToRemove(size_t nodeId, const GraphInterface::Co
         return false;
     }
     size_t nodeDestId = leftOrRight ? nodeId - 1 : nodeId + 1;
-    return isColor(nodeId, edgeId, color)
-           && nodeExists(nodeDestId) && _nodes[nodeDestId]->color != color;
+    return isColor(state, nodeId, edgeId, color)
+           && nodeExists(state, nodeDestId) && state.nodes[nodeDestId]->color != color;
 }
 
 void FlatGraph::setColor(size_t i, const GraphInterface::Color &color)
@@ -208,30 +175,38 @@ void FlatGraph::setColor(size_t i, const GraphInterface::Color &color)
     this->_nodes[i]->color = color;
 }
 
-void
-FlatGraph::sequenceMaxPushAndRemoveUtil(FlatGraph &graphCopy, std::deque<size_t> &sequenceMaxRed, size_t current) const
+void FlatGraph::removeNode(SweepState &state, size_t nodeId) const
+{
+    if (!nodeExists(state, nodeId))
+    {
+        throw GraphInterface::GraphModificationException("Node does not exist.");
+    }
+    if (edgeExists(state, nodeId) && !_edges[nodeId]->isLeft)
+    {
+        state.nodes[nodeId + 1]->color = _edges[nodeId]->color;
+    }
+    if (nodeId > 0 && edgeExists(state, nodeId - 1) && _edges[nodeId - 1]->isLeft)
+    {
+        state.nodes[nodeId - 1]->color = _edges[nodeId - 1]->color;
+    }
+    state.nodes[nodeId] = std::nullopt;
+}
+
+void FlatGraph::sequenceMaxPushAndRemoveUtil(SweepState &state, size_t current) const
 {
-    sequenceMaxRed.push_back(current);
-    graphCopy.removeNode(current); // May be useless with a stack
+    state.sink(current);
+    removeNode(state, current);
 }
 
-void FlatGraph::findNodesToRemoveBeforeUtil(FlatGraph &graphCopy, std::deque<size_t> &sequenceMax, size_t current,
-                                            const GraphInterface::Color &color, bool leftOrRight) const
+void FlatGraph::findNodesToRemoveBeforeUtil(SweepState &state, size_t current, const GraphInterface::Color &color,
+                                            bool leftOrRight) const
 {
-    static const std::function<bool(size_t, size_t)> EDGES_LEFT_OR_RIGHT = [&graphCopy](size_t leftOrRight, size_t edgeId) {
-        return (leftOrRight) != 0 == graphCopy._edges[edgeId]->isLeft;
-    };
-    static const std::function<bool(size_t, size_t, size_t)> BACK_EDGES_COMPARE_CURRENT = [](size_t leftOrRight,
-                                                                                      size_t currentTemp,
-                                                                                      size_t current) {
-        return ((leftOrRight) ? (currentTemp) < (current) : (currentTemp) > (current));
-    };
     size_t currentTemp = leftOrRight ? current - 1 : current + 1;
     size_t edgeId = leftOrRight ? current - 1 : current;
     while (true)
     {
-        if (graphCopy.nodeExists(currentTemp) && graphCopy._nodes[currentTemp]->color == color
-            && graphCopy.edgeExists(edgeId) && EDGES_LEFT_OR_RIGHT(leftOrRight, edgeId))
+        if (nodeExists(state, currentTemp) && state.nodes[currentTemp]->color == color
+            && edgeExists(state, edgeId) && leftOrRight == _edges[edgeId]->isLeft)
         {
             leftOrRight ? currentTemp-- : currentTemp++;
             leftOrRight ? edgeId-- : edgeId++;
@@ -239,9 +214,9 @@ void FlatGraph::findNodesToRemoveBeforeUtil(FlatGraph &graphCopy, std::deque<siz
         {
             leftOrRight ? currentTemp += 1 : currentTemp -= 1;
             leftOrRight ? edgeId += 1 : edgeId -= 1;
-            while (BACK_EDGES_COMPARE_CURRENT(leftOrRight, currentTemp, current))
+            while (leftOrRight ? currentTemp < current : currentTemp > current)
             {
-                sequenceMaxPushAndRemoveUtil(graphCopy, sequenceMax, currentTemp);
+                sequenceMaxPushAndRemoveUtil(state, currentTemp);
                 leftOrRight ? currentTemp++ : currentTemp--;
                 leftOrRight ? edgeId++ : edgeId--;
             }
@@ -250,43 +225,59 @@ void FlatGraph::findNodesToRemoveBeforeUtil(FlatGraph &graphCopy, std::deque<siz
     }
 }
 
-std::deque<size_t> FlatGraph::getSequenceMax(const GraphInterface::Color &color) const
+bool FlatGraph::sweepStep(SweepState &state, const GraphInterface::Color &color) const
 {
-    FlatGraph graphCopy(*this);
-    std::deque<size_t> sequenceMax;
-    size_t current = 0;
-    while (current < graphCopy.getMaxCapacity())
+    size_t &current = state.current;
+    if (current >= _maxCapacity)
+    {
+        return false;
+    }
+    if (mayBeInterestingToRemove(state, current, color, false))
     {
-        if (graphCopy.mayBeInterestingToRemove(current, color, false))
+        if (mayBeInterestingToRemove(state, current, color, true))
         {
-            if (graphCopy.mayBeInterestingToRemove(current, color, true))
-            {
-                sequenceMaxPushAndRemoveUtil(graphCopy, sequenceMax, current);
-                current--;
-            } else
-            {
-                sequenceMaxPushAndRemoveUtil(graphCopy, sequenceMax, current);
-                current++;
-            }
+            sequenceMaxPushAndRemoveUtil(state, current);
+            current--;
         } else
         {
-            if (graphCopy.mayBeInterestingToRemove(current, color, true))
-            {
-                findNodesToRemoveBeforeUtil(graphCopy, sequenceMax, current, color, false);
-                sequenceMaxPushAndRemoveUtil(graphCopy, sequenceMax, current);
-                current--;
-            } else
+            sequenceMaxPushAndRemoveUtil(state, current);
+            current++;
+        }
+    } else
+    {
+        if (mayBeInterestingToRemove(state, current, color, true))
+        {
+            findNodesToRemoveBeforeUtil(state, current, color, false);
+            sequenceMaxPushAndRemoveUtil(state, current);
+            current--;
+        } else
+        {
+            if (nodeExists(state, current) && state.nodes[current]->color == color)
             {
-                if (graphCopy.nodeExists(current) && graphCopy._nodes[current]->color == color)
-                {
-                    findNodesToRemoveBeforeUtil(graphCopy, sequenceMax, current, color, false);
-                    sequenceMaxPushAndRemoveUtil(graphCopy, sequenceMax, current);
-                }
-                current++;
+                findNodesToRemoveBeforeUtil(state, current, color, false);
+                sequenceMaxPushAndRemoveUtil(state, current);
             }
+            current++;
         }
     }
-    return sequenceMax;
+    return true;
+}
+
+std::deque<size_t> FlatGraph::getSequenceMax(const GraphInterface::Color &color) const
+{
+    std::deque<size_t> sequence;
+    getSequenceMax(color, [&sequence](size_t nodeId)
+    {
+        sequence.push_back(nodeId);
+    });
+    return sequence;
+}
+
+void FlatGraph::getSequenceMax(const GraphInterface::Color &color, const GraphInterface::SequenceSink &sink) const
+{
+    SweepState state{_nodes, sink};
+    while (sweepStep(state, color))
+    {}
 }
 
 bool FlatGraph::isEmpty() const
@@ -326,17 +317,20 @@ std::deque<size_t> FlatGraph::getSequenceMaxBis(const GraphInterface::Color &col
         }
         std::cout << std::endl;*/
     }
-    std::deque<size_t> sequenceMaxDeque;
-    FlatGraph graphCopy(*this);
+    std::deque<size_t> sequence;
+    GraphInterface::SequenceSink sink = [&sequence](size_t nodeId)
+    {
+        sequence.push_back(nodeId);
+    };
+    SweepState state{_nodes, sink};
     for(auto it = sequenceMax.begin(); it != sequenceMax.end(); it++)
     {
-        if(graphCopy.nodeExists(*it) && graphCopy._nodes[*it]->color == color)
+        if(nodeExists(state, *it) && state.nodes[*it]->color == color)
         {
-            sequenceMaxDeque.push_back(*it);
-            graphCopy.removeNode(*it);
+            sequenceMaxPushAndRemoveUtil(state, *it);
         }
     }
-    return sequenceMaxDeque;
+    return sequence;
 }
 
 bool FlatGraph::shouldBeRemovedBefore(size_t first, size_t second, const GraphInterface::Color &color) const
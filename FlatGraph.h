@@ -1,7 +1,6 @@
 #ifndef RED_BLUE_GRAPH_SOLVER_1_FLATGRAPH_H
 #define RED_BLUE_GRAPH_SOLVER_1_FLATGRAPH_H
 
-#include <random>
 #include "GraphInterface.h"
 #include <stack>
 
@@ -30,16 +29,28 @@ public:
 
     void removeNode(size_t nodeId);
 
-    void generateRandom(double redNodeProbability = 0.5, double redEdgeProbability = 0.5, double leftDirectedEdgeProbability = 0.5);
-
     [[nodiscard]] std::deque<size_t> getSequenceMax(const GraphInterface::Color &color) const;
 
+    // The nodes are given to the sink as soon as they are removed, the sequence being never held, so a CompactSequence
+    // or a file can receive the sequence of a graph too large for a deque of its nodes
+    void getSequenceMax(const GraphInterface::Color &color, const GraphInterface::SequenceSink &sink) const;
+
     [[nodiscard]] std::deque<size_t> getSequenceMaxBis(const GraphInterface::Color &color) const;
 
     bool shouldBeRemovedBefore(size_t first, size_t second, const GraphInterface::Color &color) const;
 
     friend std::ostream &operator<<(std::ostream &os, const FlatGraph &graph);
 
+    friend class FlatGraphGenerator;
+
+    friend class CoupledFlatGraphGenerator;
+
+    friend class SequenceReplay;
+
+    friend class SolverProtocol;
+
+    friend class FlatGraphBuilder;
+
 private:
     struct FlatGraphNode
     {
@@ -50,25 +61,42 @@ private:
         GraphInterface::Color color;
         bool isLeft;
     };
+    // Node colors of a sweep over the graph, whose edges are read in place: an edge only disappears with one of its
+    // nodes. The removed nodes go to the sink.
+    struct SweepState
+    {
+        std::vector<std::optional<FlatGraphNode>> nodes;
+        const GraphInterface::SequenceSink &sink;
+        size_t current = 0;
+    };
 
     size_t _maxCapacity;
     size_t _size = 0;
     std::vector<std::optional<FlatGraphNode>> _nodes;
     std::vector<std::optional<FlatGraphEdge>> _edges;
-    std::mt19937 _randomGenerator;
-    std::default_random_engine _randomEngine;
-
-    [[nodiscard]] bool isColor(size_t nodeId, size_t edgeId, const GraphInterface::Color &color) const;
 
     [[nodiscard]] bool edgeExists(size_t id) const;
 
-    [[nodiscard]] bool mayBeInterestingToRemove(size_t nodeId, const GraphInterface::Color &color, bool leftOrRight) const;
+    [[nodiscard]] bool nodeExists(const SweepState &state, size_t id) const;
+
+    [[nodiscard]] bool edgeExists(const SweepState &state, size_t id) const;
+
+    [[nodiscard]] bool isColor(const SweepState &state, size_t nodeId, size_t edgeId,
+                               const GraphInterface::Color &color) const;
+
+    [[nodiscard]] bool mayBeInterestingToRemove(const SweepState &state, size_t nodeId,
+                                                const GraphInterface::Color &color, bool leftOrRight) const;
 
     void setColor(size_t i, const GraphInterface::Color& color);
 
-    void findNodesToRemoveBeforeUtil(FlatGraph &graphCopy, std::deque<size_t> &sequenceMax, size_t current,
-                                     const GraphInterface::Color &color, bool leftOrRight) const;
-    void sequenceMaxPushAndRemoveUtil(FlatGraph &graphCopy, std::deque<size_t> &sequenceMaxRed, size_t current) const;
+    void removeNode(SweepState &state, size_t nodeId) const;
+
+    void findNodesToRemoveBeforeUtil(SweepState &state, size_t current, const GraphInterface::Color &color,
+                                     bool leftOrRight) const;
+    void sequenceMaxPushAndRemoveUtil(SweepState &state, size_t current) const;
+
+    // One move of the sweep of getSequenceMax, false once it went past the last node
+    bool sweepStep(SweepState &state, const GraphInterface::Color &color) const;
 };
 
 #endif //RED_BLUE_GRAPH_SOLVER_1_FLATGRAPH_H
\ No newline at end of file
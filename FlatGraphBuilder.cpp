@@ -0,0 +1,68 @@
+#include <algorithm>
+#include "FlatGraphBuilder.h"
+
+FlatGraphBuilder::FlatGraphBuilder(size_t maxCapacity) : _maxCapacity(maxCapacity)
+{
+}
+
+std::vector<GraphInterface::BuildError>
+FlatGraphBuilder::validate(const std::vector<GraphInterface::NodeEntry> &nodes,
+                           const std::vector<GraphInterface::EdgeEntry> &edges) const
+{
+    std::vector<GraphInterface::BuildError> errors;
+    FlatGraph graph(_maxCapacity);
+    fill(graph, nodes, edges, errors);
+    return errors;
+}
+
+std::optional<FlatGraph> FlatGraphBuilder::build(const std::vector<GraphInterface::NodeEntry> &nodes,
+                                                 const std::vector<GraphInterface::EdgeEntry> &edges,
+                                                 std::vector<GraphInterface::BuildError> &errors) const
+{
+    errors.clear();
+    FlatGraph graph(_maxCapacity);
+    fill(graph, nodes, edges, errors);
+    if (!errors.empty())
+    {
+        return std::nullopt;
+    }
+    return graph;
+}
+
+void FlatGraphBuilder::fill(FlatGraph &graph, const std::vector<GraphInterface::NodeEntry> &nodes,
+                            const std::vector<GraphInterface::EdgeEntry> &edges,
+                            std::vector<GraphInterface::BuildError> &errors) const
+{
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        const GraphInterface::NodeEntry &node = nodes[i];
+        if (node.id >= _maxCapacity)
+        {
+            errors.push_back({GraphInterface::BuildError::NODE, i, "Node id is too big."});
+        } else if (graph._nodes[node.id].has_value())
+        {
+            errors.push_back({GraphInterface::BuildError::NODE, i, "Node already exists."});
+        } else
+        {
+            graph._nodes[node.id] = FlatGraph::FlatGraphNode{node.color};
+            graph._size++;
+        }
+    }
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        const GraphInterface::EdgeEntry &edge = edges[i];
+        if (!graph.nodeExists(edge.from) || !graph.nodeExists(edge.to))
+        {
+            errors.push_back({GraphInterface::BuildError::EDGE, i, "Node does not exist."});
+        } else if (edge.from - edge.to != 1 && edge.to - edge.from != 1)
+        {
+            errors.push_back({GraphInterface::BuildError::EDGE, i, "Nodes are not adjacent."});
+        } else if (graph._edges[std::min(edge.from, edge.to)].has_value())
+        {
+            errors.push_back({GraphInterface::BuildError::EDGE, i, "Edge already exists."});
+        } else
+        {
+            graph._edges[std::min(edge.from, edge.to)] = FlatGraph::FlatGraphEdge{edge.color, edge.from - edge.to == 1};
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHBUILDER_H
+#define RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHBUILDER_H
+
+#include <optional>
+#include <vector>
+#include "FlatGraph.h"
+
+// Builds a FlatGraph from arrays of nodes and edges, as GraphBuilder does for Graph: every rejected entry is listed,
+// with the message of the exception of FlatGraph, instead of throwing. The graph is filled while the entries are
+// checked, its nodes and edges being already stored in two arrays.
+class FlatGraphBuilder
+{
+public:
+    FlatGraphBuilder() = delete;
+    explicit FlatGraphBuilder(size_t maxCapacity);
+    FlatGraphBuilder(const FlatGraphBuilder &otherBuilder) = default;
+    FlatGraphBuilder &operator=(const FlatGraphBuilder &other) = default;
+    ~FlatGraphBuilder() = default;
+
+    // Rejected entries, the nodes then the edges, each in the order of its array: empty when build succeeds
+    [[nodiscard]] std::vector<GraphInterface::BuildError>
+    validate(const std::vector<GraphInterface::NodeEntry> &nodes,
+             const std::vector<GraphInterface::EdgeEntry> &edges) const;
+
+    // std::nullopt when an entry is rejected, errors being the ones of validate
+    [[nodiscard]] std::optional<FlatGraph> build(const std::vector<GraphInterface::NodeEntry> &nodes,
+                                                 const std::vector<GraphInterface::EdgeEntry> &edges,
+                                                 std::vector<GraphInterface::BuildError> &errors) const;
+
+private:
+    size_t _maxCapacity;
+
+    void fill(FlatGraph &graph, const std::vector<GraphInterface::NodeEntry> &nodes,
+              const std::vector<GraphInterface::EdgeEntry> &edges,
+              std::vector<GraphInterface::BuildError> &errors) const;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHBUILDER_H
@@ -0,0 +1,41 @@
+#include "FlatGraphGenerator.h"
+
+FlatGraphGenerator::FlatGraphGenerator(uint64_t seed) : _randomGenerator(seed), _distribution(0, 1)
+{}
+
+FlatGraph FlatGraphGenerator::generate(size_t maxCapacity, double redNodeProbability, double redEdgeProbability,
+                                       double leftDirectedEdgeProbability)
+{
+    FlatGraph graph(maxCapacity);
+    generate(graph, redNodeProbability, redEdgeProbability, leftDirectedEdgeProbability);
+    return graph;
+}
+
+void FlatGraphGenerator::generate(FlatGraph &graph, double redNodeProbability, double redEdgeProbability,
+                                  double leftDirectedEdgeProbability)
+{
+    for (std::optional<FlatGraph::FlatGraphNode> &node: graph._nodes)
+    {
+        if (_distribution(_randomGenerator) < redNodeProbability)
+        {
+            node = FlatGraph::FlatGraphNode{GraphInterface::Color::RED};
+        } else
+        {
+            node = FlatGraph::FlatGraphNode{GraphInterface::Color::BLUE};
+        }
+    }
+    for (std::optional<FlatGraph::FlatGraphEdge> &edge: graph._edges)
+    {
+        FlatGraph::FlatGraphEdge flatGraphEdge{};
+        if (_distribution(_randomGenerator) < redEdgeProbability)
+        {
+            flatGraphEdge.color = GraphInterface::Color::RED;
+        } else
+        {
+            flatGraphEdge.color = GraphInterface::Color::BLUE;
+        }
+        flatGraphEdge.isLeft = _distribution(_randomGenerator) < leftDirectedEdgeProbability;
+        edge = flatGraphEdge;
+    }
+    graph._size = graph._maxCapacity;
+}
@@ -0,0 +1,30 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHGENERATOR_H
+#define RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHGENERATOR_H
+
+#include <random>
+#include "FlatGraph.h"
+
+// Random complete FlatGraphs. The generator owns the random state, so that a graph is only its nodes and edges and
+// two generators built with the same seed give the same graphs.
+class FlatGraphGenerator
+{
+public:
+    FlatGraphGenerator() = delete;
+    explicit FlatGraphGenerator(uint64_t seed);
+    FlatGraphGenerator(const FlatGraphGenerator &otherGenerator) = default;
+    FlatGraphGenerator &operator=(const FlatGraphGenerator &other) = default;
+    ~FlatGraphGenerator() = default;
+
+    [[nodiscard]] FlatGraph generate(size_t maxCapacity, double redNodeProbability = 0.5,
+                                     double redEdgeProbability = 0.5, double leftDirectedEdgeProbability = 0.5);
+
+    // Overwrites every node and edge of the graph, without reallocating it
+    void generate(FlatGraph &graph, double redNodeProbability = 0.5, double redEdgeProbability = 0.5,
+                  double leftDirectedEdgeProbability = 0.5);
+
+private:
+    std::mt19937_64 _randomGenerator;
+    std::uniform_real_distribution<float> _distribution;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHGENERATOR_H
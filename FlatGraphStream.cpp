@@ -0,0 +1,93 @@
+#include <stdexcept>
+#include "FlatGraphStream.h"
+
+FlatGraphByteStream::FlatGraphByteStream(std::istream &stream) : _stream(stream), _buffer(BUFFER_SIZE)
+{}
+
+bool FlatGraphByteStream::next(Element &element)
+{
+    uint8_t byte;
+    element.leftEdge = std::nullopt;
+    if (!_isFirst)
+    {
+        if (!readByte(byte))
+        {
+            return false;
+        }
+        if (byte > 6 || (byte & 3) == 3 || (byte != 0 && (byte & 3) == 0))
+        {
+            throw std::runtime_error("Invalid edge byte in the flat graph stream");
+        }
+        if (byte != 0)
+        {
+            element.leftEdge = Edge{(byte & 3) == 1 ? GraphInterface::Color::RED : GraphInterface::Color::BLUE,
+                                    (byte & 4) != 0};
+        }
+    }
+    if (!readByte(byte))
+    {
+        if (_isFirst)
+        {
+            return false;
+        }
+        throw std::runtime_error("Flat graph stream ends after an edge");
+    }
+    if (byte > 2)
+    {
+        throw std::runtime_error("Invalid node byte in the flat graph stream");
+    }
+    element.color = std::nullopt;
+    if (byte != 0)
+    {
+        element.color = byte == 1 ? GraphInterface::Color::RED : GraphInterface::Color::BLUE;
+    }
+    _isFirst = false;
+    return true;
+}
+
+bool FlatGraphByteStream::readByte(uint8_t &byte)
+{
+    if (_position == _end)
+    {
+        _stream.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _position = 0;
+        _end = static_cast<size_t>(_stream.gcount());
+        if (_end == 0)
+        {
+            if (_stream.bad())
+            {
+                throw std::runtime_error("Cannot read the flat graph stream");
+            }
+            return false;
+        }
+    }
+    byte = static_cast<uint8_t>(_buffer[_position++]);
+    return true;
+}
+
+RandomFlatGraphStream::RandomFlatGraphStream(uint64_t seed, size_t nodeCount, double redNodeProbability,
+                                             double redEdgeProbability, double leftDirectedEdgeProbability)
+        : _randomGenerator(seed), _distribution(0, 1), _nodeCount(nodeCount), _redNodeProbability(redNodeProbability),
+          _redEdgeProbability(redEdgeProbability), _leftDirectedEdgeProbability(leftDirectedEdgeProbability)
+{}
+
+bool RandomFlatGraphStream::next(Element &element)
+{
+    if (_readCount == _nodeCount)
+    {
+        return false;
+    }
+    element.leftEdge = std::nullopt;
+    if (_readCount > 0)
+    {
+        Edge edge{};
+        edge.color = _distribution(_randomGenerator) < _redEdgeProbability ? GraphInterface::Color::RED
+                                                                           : GraphInterface::Color::BLUE;
+        edge.isLeft = _distribution(_randomGenerator) < _leftDirectedEdgeProbability;
+        element.leftEdge = edge;
+    }
+    element.color = _distribution(_randomGenerator) < _redNodeProbability ? GraphInterface::Color::RED
+                                                                         : GraphInterface::Color::BLUE;
+    _readCount++;
+    return true;
+}
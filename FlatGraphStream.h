@@ -0,0 +1,83 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHSTREAM_H
+#define RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHSTREAM_H
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <random>
+#include <vector>
+#include "GraphInterface.h"
+
+// Nodes of a flat graph read from left to right, each one with the edge linking it to the previous node, for the
+// graphs too big to be held in a FlatGraph
+class FlatGraphStream
+{
+public:
+    struct Edge
+    {
+        GraphInterface::Color color;
+        // The edge goes from the node to the previous one
+        bool isLeft;
+    };
+
+    struct Element
+    {
+        // std::nullopt when there is no node
+        std::optional<GraphInterface::Color> color;
+        // Edge with the previous node, std::nullopt for the first node
+        std::optional<Edge> leftEdge;
+    };
+
+    virtual ~FlatGraphStream() = default;
+
+    // False once the last node was read
+    virtual bool next(Element &element) = 0;
+};
+
+// Bytes of SolverProtocol from a file or a pipe, without the node count: the node byte of the node 0, then the edge
+// byte and the node byte of each next node
+class FlatGraphByteStream : public FlatGraphStream
+{
+public:
+    FlatGraphByteStream() = delete;
+    explicit FlatGraphByteStream(std::istream &stream);
+    FlatGraphByteStream(const FlatGraphByteStream &otherStream) = delete;
+    ~FlatGraphByteStream() override = default;
+
+    bool next(Element &element) override;
+
+private:
+    static constexpr size_t BUFFER_SIZE = size_t(1) << 16;
+
+    std::istream &_stream;
+    std::vector<char> _buffer;
+    size_t _position = 0;
+    size_t _end = 0;
+    bool _isFirst = true;
+
+    bool readByte(uint8_t &byte);
+};
+
+// Random complete flat graph drawn node by node, with the probabilities of FlatGraphGenerator
+class RandomFlatGraphStream : public FlatGraphStream
+{
+public:
+    RandomFlatGraphStream() = delete;
+    RandomFlatGraphStream(uint64_t seed, size_t nodeCount, double redNodeProbability = 0.5,
+                          double redEdgeProbability = 0.5, double leftDirectedEdgeProbability = 0.5);
+    RandomFlatGraphStream(const RandomFlatGraphStream &otherStream) = default;
+    ~RandomFlatGraphStream() override = default;
+
+    bool next(Element &element) override;
+
+private:
+    std::mt19937_64 _randomGenerator;
+    std::uniform_real_distribution<float> _distribution;
+    size_t _nodeCount;
+    size_t _readCount = 0;
+    double _redNodeProbability;
+    double _redEdgeProbability;
+    double _leftDirectedEdgeProbability;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_FLATGRAPHSTREAM_H
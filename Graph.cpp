@@ -1,28 +1,61 @@
 #include <iostream>
 #include <algorithm>
+#include <memory>
 #include <queue>
 #include <tuple>
 #include "Graph.h"
 #include "Node.h"
+#include "NodeSymmetry.h"
+#include "CompactGraph.h"
+#include "ExternalFrontier.h"
+#include "GraphHeuristic.h"
+#include "IdaStarSearch.h"
+#include "StateSearch.h"
 
 Graph::Graph(size_t maxCapacity) : _maxCapacity(maxCapacity)
 {
     _nodes.resize(maxCapacity);
 }
 
-
-void Graph::createNode(const GraphInterface::Color &color, size_t id)
+Graph::Graph(const CompactGraph &compactGraph) : _maxCapacity(compactGraph.getMaxCapacity())
 {
-    if (nodeExists(id))
+    const CompactGraph::State &state = compactGraph.getInitialState();
+    _nodes.resize(_maxCapacity);
+    for (size_t i = 0; i < _maxCapacity; ++i)
     {
-        throw GraphInterface::GraphModificationException("Node already exists");
+        if (compactGraph.nodeExists(state, i))
+        {
+            createNode(compactGraph.getColor(state, i), i);
+        }
     }
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        if (!nodeExists(i))
+        {
+            continue;
+        }
+        // The out-edges are sorted by target, so each one goes at the end of the neighbors
+        NeighborList &neighbors = _nodes[i]->_neighbors;
+        for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(i))
+        {
+            neighbors.insert(edge.node, edge.color);
+        }
+    }
+}
+
+
+void Graph::createNode(const GraphInterface::Color &color, size_t id)
+{
     if (id >= _maxCapacity)
     {
         throw GraphInterface::GraphModificationException("Node id is out of bounds");
     }
+    if (nodeExists(id))
+    {
+        throw GraphInterface::GraphModificationException("Node already exists");
+    }
     _size++;
-    _nodes[id] = std::unique_ptr<Node>(new Node(this, color, id));
+    _nodes[id] = Node(color, id);
 }
 
 void Graph::addEdge(size_t from, size_t to, const GraphInterface::Color &color)
@@ -31,40 +64,28 @@ void Graph::addEdge(size_t from, size_t to, const GraphInterface::Color &color)
     {
         throw GraphInterface::GraphModificationException("Invalid node index");
     }
-    _nodes[from].value()->addNeighbor(to, color);
+    _nodes[from]->addNeighbor(to, color);
 }
 
 std::ostream &operator<<(std::ostream &os, const Graph &graph)
 {
-    for (const std::optional<std::unique_ptr<Node>> &node : graph._nodes)
+    for (const std::optional<Node> &node : graph._nodes)
     {
         if (node.has_value())
         {
-            os << **node << std::endl;
+            os << *node << std::endl;
         }
     }
     return os;
 }
 
-Graph::Graph(const Graph &otherGraph) : _maxCapacity(otherGraph._maxCapacity), _size(otherGraph._size)
-{
-    _nodes.resize(otherGraph._nodes.size());
-    for (size_t i = 0; i < _nodes.size(); ++i)
-    {
-        if (otherGraph._nodes[i].has_value())
-        {
-            _nodes[i] = std::unique_ptr<Node>(new Node(this, **otherGraph._nodes[i]));
-        }
-    }
-}
-
-Node &Graph::getNode(size_t id) const
+const Node &Graph::getNode(size_t id) const
 {
     if(!nodeExists(id))
     {
         throw GraphInterface::GraphModificationException("Node does not exist");
     }
-    return **_nodes[id];
+    return *_nodes[id];
 }
 
 void Graph::removeNode(size_t id)
@@ -73,20 +94,18 @@ void Graph::removeNode(size_t id)
     {
         throw GraphInterface::GraphModificationException("Node does not exist");
     }
-    _nodes[id]->get()->propagateColorToNeighbors();
-    for (std::optional<std::unique_ptr<Node>> &node: _nodes)
+    for (const NeighborList::Neighbor &neighbor: _nodes[id]->_neighbors)
     {
-        if (!node.has_value())
-        {
-            continue;
-        }
-        try
+        if (nodeExists(neighbor.id))
         {
-            node->get()->removeNeighbor(id);
+            _nodes[neighbor.id]->setColor(neighbor.color);
         }
-        catch (std::exception &e)
+    }
+    for (std::optional<Node> &node: _nodes)
+    {
+        if (node.has_value())
         {
-            // Ignore exception here
+            node->_neighbors.erase(id);
         }
     }
     _nodes[id] = std::nullopt;
@@ -113,45 +132,134 @@ bool Graph::nodeExists(size_t id) const
     return _size;
 }
 
+// Graph, run and sequence of a state of the search, with the twin classes of its parent shared by its siblings: the
+// classes of the state are only computed from them when it is expanded, most states never being
+using GraphState = std::tuple<Graph, size_t, std::deque<size_t>, std::shared_ptr<const NodeSymmetry>>;
+
 class QueueSequenceTupleComparator
 {
 public:
-    bool operator()(const std::tuple<Graph, size_t, std::deque<size_t>> &t1,
-                    const std::tuple<Graph, size_t, std::deque<size_t>> &t2) const
+    bool operator()(const GraphState &t1, const GraphState &t2) const
     {
         return std::get<1>(t1) < std::get<1>(t2);
     }
 };
 
+using GraphStatesQueue = std::priority_queue<GraphState, std::vector<GraphState>, QueueSequenceTupleComparator>;
+
+namespace
+{
+    // Moves of the heuristic seeding an exact search. A count rather than a time, so that the sequence returned among
+    // the ones of the same run does not depend on the speed of the machine.
+    constexpr size_t SEED_MOVE_COUNT = 256;
+
+    size_t getEntryBytes(const GraphState &entry)
+    {
+        // The classes shared by siblings are counted with each of them
+        return sizeof(entry) - sizeof(Graph) + std::get<0>(entry).getMemoryUsage()
+               + std::get<2>(entry).size() * sizeof(size_t) + std::get<3>(entry)->getMemoryUsage();
+    }
+
+    // Empties the queue of a search stopped by its budget, whose states are sequences as valid as the best one
+    void releaseFrontier(GraphStatesQueue &graphStatesQueue, MemoryBudget &budget,
+                         std::pair<size_t, std::deque<size_t>> &sequenceMax)
+    {
+        while (!graphStatesQueue.empty())
+        {
+            const GraphState &entry = graphStatesQueue.top();
+            budget.release(getEntryBytes(entry));
+            if (std::get<1>(entry) > sequenceMax.first)
+            {
+                sequenceMax = std::make_pair(std::get<1>(entry), std::get<2>(entry));
+            }
+            graphStatesQueue.pop();
+        }
+    }
+
+    // Twin classes of a state from the ones of its parent, the last node of the sequence being the one removed
+    std::shared_ptr<const NodeSymmetry> getSymmetry(const NodeSymmetry &parentSymmetry, const Graph &graph,
+                                                    const std::deque<size_t> &sequence)
+    {
+        std::shared_ptr<NodeSymmetry> symmetry = std::make_shared<NodeSymmetry>(parentSymmetry);
+        if (!sequence.empty())
+        {
+            symmetry->removeNode(graph, sequence.back());
+        }
+        return symmetry;
+    }
+
+    // Calls function with the color count of the graph as an std::integral_constant, for the searches compiled for
+    // each number of colors
+    template<typename Function>
+    auto withColorCount(size_t colorCount, const Function &function)
+    {
+        switch (colorCount)
+        {
+            case 2:
+                return function(std::integral_constant<size_t, 2>());
+            case 3:
+                return function(std::integral_constant<size_t, 3>());
+            case 4:
+                return function(std::integral_constant<size_t, 4>());
+            default:
+                throw GraphInterface::GraphModificationException("Color out of range");
+        }
+    }
+}
+
 std::optional<std::deque<size_t>> Graph::getSequence(GraphInterface::Color color, size_t k) const
 {
-    std::priority_queue<std::tuple<Graph, size_t, std::deque<size_t>>, std::vector<std::tuple<Graph, size_t, std::deque<size_t>>>, QueueSequenceTupleComparator> graphStatesQueue;
-    graphStatesQueue.push(std::make_tuple(*this, 0, std::deque<size_t>()));
+    MemoryBudget budget;
+    return getSequence(color, k, budget);
+}
+
+std::optional<std::deque<size_t>> Graph::getSequence(GraphInterface::Color color, size_t k,
+                                                     MemoryBudget &budget) const
+{
+    GraphStatesQueue graphStatesQueue;
+    GraphState root(*this, 0, std::deque<size_t>(), std::make_shared<const NodeSymmetry>(*this));
+    if (!budget.tryCharge(getEntryBytes(root)))
+    {
+        return std::nullopt;
+    }
+    graphStatesQueue.push(std::move(root));
     while (!graphStatesQueue.empty())
     {
-        auto[graph, alreadyRemoved, sequenceToDisplay] = graphStatesQueue.top();
+        budget.release(getEntryBytes(graphStatesQueue.top()));
+        auto[graph, alreadyRemoved, sequenceToDisplay, parentSymmetry] = graphStatesQueue.top();
         graphStatesQueue.pop();
         if (alreadyRemoved == k)
         {
+            std::pair<size_t, std::deque<size_t>> unused;
+            releaseFrontier(graphStatesQueue, budget, unused);
             return sequenceToDisplay;
         }
         if (k > alreadyRemoved + graph.size())
         {
             continue;
         }
+        std::shared_ptr<const NodeSymmetry> symmetry = getSymmetry(*parentSymmetry, graph, sequenceToDisplay);
         for (size_t i = 0; i < graph._nodes.size(); ++i)
         {
-            if (!graph._nodes[i].has_value())
+            // Removing a twin of the representative leads to the same graph up to the exchange of the two
+            if (!graph._nodes[i].has_value() || !symmetry->isRepresentative(i))
             {
                 continue;
             }
-            bool goodColorHasBeenRemoved = graph._nodes[i]->get()->getColor() == color;
+            bool goodColorHasBeenRemoved = graph._nodes[i]->getColor() == color;
             Graph graphCopy(graph);
             graphCopy.removeNode(i);
             sequenceToDisplay.push_back(i);
-            graphStatesQueue.push(
-                    std::make_tuple(graphCopy, (goodColorHasBeenRemoved ? alreadyRemoved + 1 : 0), sequenceToDisplay));
+            GraphState child(std::move(graphCopy), (goodColorHasBeenRemoved ? alreadyRemoved + 1 : 0),
+                             sequenceToDisplay, symmetry);
             sequenceToDisplay.pop_back();
+            if (!budget.tryCharge(getEntryBytes(child)))
+            {
+                std::pair<size_t, std::deque<size_t>> unused;
+                releaseFrontier(graphStatesQueue, budget, unused);
+                return std::nullopt;
+            }
+            graphStatesQueue.push(std::move(child));
         }
     }
     return std::nullopt;
@@ -159,59 +267,245 @@ std::optional<std::deque<size_t>> Graph::getSequence(GraphInterface::Color color
 
 std::pair<size_t, std::deque<size_t>> Graph::getSequenceMax(GraphInterface::Color color) const
 {
-    std::priority_queue<std::tuple<Graph, size_t, std::deque<size_t>>, std::vector<std::tuple<Graph, size_t, std::deque<size_t>>>, QueueSequenceTupleComparator> graphStatesQueue;
-    std::pair<size_t, std::deque<size_t>> sequenceMax;
-    graphStatesQueue.push(std::make_tuple(*this, 0, std::deque<size_t>()));
+    MemoryBudget budget;
+    return getSequenceMax(color, budget);
+}
+
+std::pair<size_t, std::deque<size_t>> Graph::getSequenceMax(GraphInterface::Color color, MemoryBudget &budget) const
+{
+    GraphStatesQueue graphStatesQueue;
+    std::pair<size_t, std::deque<size_t>> sequenceMax = getSequenceHeuristic(color, SEED_MOVE_COUNT);
+    GraphState root(*this, 0, std::deque<size_t>(), std::make_shared<const NodeSymmetry>(*this));
+    if (!budget.tryCharge(getEntryBytes(root)))
+    {
+        return sequenceMax;
+    }
+    graphStatesQueue.push(std::move(root));
     while (!graphStatesQueue.empty())
     {
-        auto[graph, alreadyRemoved, sequenceToDisplay] = graphStatesQueue.top();
+        budget.release(getEntryBytes(graphStatesQueue.top()));
+        auto[graph, alreadyRemoved, sequenceToDisplay, parentSymmetry] = graphStatesQueue.top();
         graphStatesQueue.pop();
+        // Only computed for the first child, many states having none
+        std::shared_ptr<const NodeSymmetry> symmetry;
         for (size_t i = 0; i < graph._nodes.size(); ++i)
         {
             if (!graph._nodes[i].has_value())
             {
                 continue;
             }
-            bool goodColorHasBeenRemoved = graph._nodes[i]->get()->getColor() == color;
+            bool goodColorHasBeenRemoved = graph._nodes[i]->getColor() == color;
             if(!goodColorHasBeenRemoved && ((graphStatesQueue.empty() || graph.size() <= std::get<1>(graphStatesQueue.top())) || graph.size() <= sequenceMax.first) )
             {
-                if(sequenceToDisplay.size() > sequenceMax.second.size())
+                if(alreadyRemoved > sequenceMax.first)
                 {
                     sequenceMax = std::make_pair(alreadyRemoved, sequenceToDisplay);
                 }
                 continue;
             }
+            if (symmetry == nullptr)
+            {
+                symmetry = getSymmetry(*parentSymmetry, graph, sequenceToDisplay);
+            }
+            // Removing a twin of the representative leads to the same graph up to the exchange of the two
+            if (!symmetry->isRepresentative(i))
+            {
+                continue;
+            }
             Graph graphCopy(graph);
             graphCopy.removeNode(i);
             sequenceToDisplay.push_back(i);
-            graphStatesQueue.push(
-                    std::make_tuple(graphCopy, (goodColorHasBeenRemoved ? alreadyRemoved + 1 : 0), sequenceToDisplay));
+            GraphState child(std::move(graphCopy), (goodColorHasBeenRemoved ? alreadyRemoved + 1 : 0),
+                             sequenceToDisplay, symmetry);
             sequenceToDisplay.pop_back();
+            if (!budget.tryCharge(getEntryBytes(child)))
+            {
+                if (alreadyRemoved > sequenceMax.first)
+                {
+                    sequenceMax = std::make_pair(alreadyRemoved, sequenceToDisplay);
+                }
+                releaseFrontier(graphStatesQueue, budget, sequenceMax);
+                return sequenceMax;
+            }
+            graphStatesQueue.push(std::move(child));
         }
     }
     return sequenceMax;
 }
 
-Graph &Graph::operator=(const Graph &other)
+std::pair<size_t, std::deque<size_t>> Graph::getSequenceMaxExact(GraphInterface::Color color,
+                                                                 const std::filesystem::path &checkpointPath,
+                                                                 size_t threadCount,
+                                                                 std::chrono::milliseconds interval) const
+{
+    MemoryBudget budget;
+    return getSequenceMaxExact(color, checkpointPath, budget, threadCount, interval);
+}
+
+std::pair<size_t, std::deque<size_t>> Graph::getSequenceMaxExact(GraphInterface::Color color,
+                                                                 const std::filesystem::path &checkpointPath,
+                                                                 MemoryBudget &budget, size_t threadCount,
+                                                                 std::chrono::milliseconds interval) const
 {
-    for (std::optional<std::unique_ptr<Node>> &node: _nodes)
+    return withColorCount(getColorCount(), [&](auto colorCount)
     {
-        if (node.has_value())
+        BasicCompactGraph<colorCount()> compactGraph(*this);
+        BasicStateSearch<colorCount()> search(compactGraph, color);
+        search.setThreadCount(threadCount);
+        search.setCheckpoint(checkpointPath, interval);
+        search.setMemoryBudget(&budget);
+        BasicGraphHeuristic<colorCount()> heuristic(compactGraph, color);
+        return search.solveMax(heuristic.solve(SEED_MOVE_COUNT));
+    });
+}
+
+std::pair<std::pair<size_t, std::deque<size_t>>, std::pair<size_t, std::deque<size_t>>>
+Graph::getSequenceMaxBothColors() const
+{
+    MemoryBudget budget;
+    return getSequenceMaxBothColors(budget);
+}
+
+std::pair<std::pair<size_t, std::deque<size_t>>, std::pair<size_t, std::deque<size_t>>>
+Graph::getSequenceMaxBothColors(MemoryBudget &budget) const
+{
+    return withColorCount(getColorCount(), [&](auto colorCount)
+    {
+        BasicCompactGraph<colorCount()> compactGraph(*this);
+        BasicStateSearch<colorCount()> search(compactGraph, GraphInterface::Color::RED);
+        search.setMemoryBudget(&budget);
+        BasicGraphHeuristic<colorCount()> redHeuristic(compactGraph, GraphInterface::Color::RED);
+        BasicGraphHeuristic<colorCount()> blueHeuristic(compactGraph, GraphInterface::Color::BLUE);
+        return search.solveMaxBothColors(redHeuristic.solve(SEED_MOVE_COUNT),
+                                         blueHeuristic.solve(SEED_MOVE_COUNT));
+    });
+}
+
+SequenceTable Graph::getSequences(GraphInterface::Color color) const
+{
+    MemoryBudget budget;
+    return getSequences(color, budget);
+}
+
+SequenceTable Graph::getSequences(GraphInterface::Color color, MemoryBudget &budget) const
+{
+    return withColorCount(getColorCount(), [&](auto colorCount)
+    {
+        BasicCompactGraph<colorCount()> compactGraph(*this);
+        BasicStateSearch<colorCount()> search(compactGraph, color);
+        search.setMemoryBudget(&budget);
+        BasicGraphHeuristic<colorCount()> heuristic(compactGraph, color);
+        std::pair<size_t, std::deque<size_t>> sequenceMax = search.solveMax(heuristic.solve(SEED_MOVE_COUNT));
+        return SequenceTable(sequenceMax.first, std::move(sequenceMax.second));
+    });
+}
+
+std::pair<size_t, std::deque<size_t>> Graph::getSequenceHeuristic(GraphInterface::Color color,
+                                                                  std::chrono::microseconds timeBudget) const
+{
+    return withColorCount(getColorCount(), [&](auto colorCount)
+    {
+        BasicCompactGraph<colorCount()> compactGraph(*this);
+        BasicGraphHeuristic<colorCount()> heuristic(compactGraph, color);
+        return heuristic.solve(timeBudget);
+    });
+}
+
+std::pair<size_t, std::deque<size_t>> Graph::getSequenceHeuristic(GraphInterface::Color color, size_t moveBudget) const
+{
+    return withColorCount(getColorCount(), [&](auto colorCount)
+    {
+        BasicCompactGraph<colorCount()> compactGraph(*this);
+        BasicGraphHeuristic<colorCount()> heuristic(compactGraph, color);
+        return heuristic.solve(moveBudget);
+    });
+}
+
+std::optional<std::deque<size_t>> Graph::getSequenceExternal(GraphInterface::Color color, size_t k, size_t memoryBudget,
+                                                             const std::filesystem::path &spillDirectory) const
+{
+    CompactGraph compactGraph(*this);
+    ExternalFrontier frontier(compactGraph, memoryBudget, spillDirectory);
+    frontier.push(CompactGraph::State(compactGraph.getInitialState()));
+    while (std::optional<CompactGraph::State> state = frontier.pop())
+    {
+        if (state->run == k)
+        {
+            return std::deque<size_t>(state->sequence.begin(), state->sequence.end());
+        }
+        if (k > state->run + compactGraph.size(*state))
+        {
+            continue;
+        }
+        for (size_t i = 0; i < _maxCapacity; ++i)
+        {
+            if (!compactGraph.nodeExists(*state, i))
+            {
+                continue;
+            }
+            CompactGraph::State child(*state);
+            bool goodColorHasBeenRemoved = compactGraph.getColor(child, i) == color;
+            compactGraph.removeNode(child, i);
+            child.run = goodColorHasBeenRemoved ? state->run + 1 : 0;
+            child.sequence.push_back(static_cast<uint32_t>(i));
+            frontier.push(std::move(child));
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::deque<size_t>> Graph::getSequenceIdaStar(GraphInterface::Color color, size_t k,
+                                                             size_t transpositionTableCapacity) const
+{
+    MemoryBudget budget;
+    return getSequenceIdaStar(color, k, budget, transpositionTableCapacity);
+}
+
+std::optional<std::deque<size_t>> Graph::getSequenceIdaStar(GraphInterface::Color color, size_t k,
+                                                             MemoryBudget &budget,
+                                                             size_t transpositionTableCapacity) const
+{
+    CompactGraph compactGraph(*this);
+    IdaStarSearch search(compactGraph, color);
+    search.setMemoryBudget(&budget);
+    std::optional<TranspositionTable> table;
+    if (transpositionTableCapacity > 0)
+    {
+        table.emplace(transpositionTableCapacity);
+        search.setTranspositionTable(&*table);
+    }
+    return search.getSequence(k);
+}
+
+size_t Graph::getColorCount() const
+{
+    size_t colorCount = 2;
+    for (const std::optional<Node> &node: _nodes)
+    {
+        if (!node.has_value())
         {
-            node = std::nullopt;
+            continue;
+        }
+        colorCount = std::max(colorCount, static_cast<size_t>(node->_color) + 1);
+        for (const NeighborList::Neighbor &neighbor: node->_neighbors)
+        {
+            colorCount = std::max(colorCount, static_cast<size_t>(neighbor.color) + 1);
         }
     }
-    _nodes.resize(other._nodes.size());
-    _size = other._size;
-    _maxCapacity = other._maxCapacity;
-    for (size_t i = 0; i < _nodes.size(); ++i)
+    return colorCount;
+}
+
+size_t Graph::getMemoryUsage() const
+{
+    size_t bytes = sizeof(Graph) + _nodes.size() * sizeof(std::optional<Node>);
+    for (const std::optional<Node> &node: _nodes)
     {
-        if (other._nodes[i].has_value())
+        if (node.has_value() && node->_neighbors.size() > NeighborList::INLINE_CAPACITY)
         {
-            _nodes[i] = std::unique_ptr<Node>(new Node(this, other.getNode(i)));
+            bytes += node->_neighbors.size() * sizeof(NeighborList::Neighbor);
         }
     }
-    return *this;
+    return bytes;
 }
 
 bool operator==(const Graph &g1, const Graph &g2)
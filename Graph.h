@@ -5,11 +5,17 @@
 #include <vector>
 #include <deque>
 #include <exception>
-#include <memory>
+#include <optional>
+#include <filesystem>
+#include <chrono>
 #include "GraphInterface.h"
+#include "MemoryBudget.h"
 #include "Node.h"
+#include "SequenceTable.h"
 
 class Node;
+template<size_t COLOR_COUNT> class BasicCompactGraph;
+using CompactGraph = BasicCompactGraph<2>;
 
 class Graph : public GraphInterface
 {
@@ -18,11 +24,18 @@ public:
 
     explicit Graph(size_t maxCapacity);
 
-    Graph(const Graph &otherGraph);
+    // Graph of the initial state of a compact graph, the one of a GraphGenerator for instance
+    explicit Graph(const CompactGraph &compactGraph);
+
+    Graph(const Graph &otherGraph) = default;
+
+    Graph(Graph &&otherGraph) noexcept = default;
 
     ~Graph() = default;
 
-    Graph &operator=(const Graph &other);
+    Graph &operator=(const Graph &other) = default;
+
+    Graph &operator=(Graph &&other) noexcept = default;
 
     void createNode(const GraphInterface::Color &color, size_t id);
 
@@ -30,28 +43,98 @@ public:
 
     [[nodiscard]] bool nodeExists(size_t id) const;
 
-    [[nodiscard]] Node &getNode(size_t id) const;
+    [[nodiscard]] const Node &getNode(size_t id) const;
 
     void removeNode(size_t id);
 
     [[nodiscard]] std::optional<std::deque<size_t>> getSequence(GraphInterface::Color color, size_t k) const;
 
+    // Also std::nullopt when the search went over the budget, which is then exceeded
+    [[nodiscard]] std::optional<std::deque<size_t>> getSequence(GraphInterface::Color color, size_t k,
+                                                                MemoryBudget &budget) const;
+
+    // Best-first search whose pruning is a heuristic, so that the run may be below the maximum: getSequenceMaxExact
+    // and getSequences prove it
     [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceMax(GraphInterface::Color color) const;
 
+    // The states of the search are charged to the budget: when it is exceeded, the search stops and the best
+    // sequence found so far is returned
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceMax(GraphInterface::Color color,
+                                                                      MemoryBudget &budget) const;
+
+    // Exact search saved to the checkpoint file while it runs, and resumed from it when the file exists
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceMaxExact(GraphInterface::Color color,
+                                                                           const std::filesystem::path &checkpointPath,
+                                                                           size_t threadCount = 1,
+                                                                           std::chrono::milliseconds interval = std::chrono::minutes(5)) const;
+
+    // The layers of the search are charged to the budget: when it is exceeded, the best sequence found so far is
+    // returned and the checkpoint file keeps the last complete layer
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceMaxExact(GraphInterface::Color color,
+                                                                           const std::filesystem::path &checkpointPath,
+                                                                           MemoryBudget &budget, size_t threadCount = 1,
+                                                                           std::chrono::milliseconds interval = std::chrono::minutes(5)) const;
+
+    // Red then blue maxima, found by a single exact search over the states of the graph
+    [[nodiscard]] std::pair<std::pair<size_t, std::deque<size_t>>, std::pair<size_t, std::deque<size_t>>>
+    getSequenceMaxBothColors() const;
+
+    // Over the budget, the best sequences of both colors found so far
+    [[nodiscard]] std::pair<std::pair<size_t, std::deque<size_t>>, std::pair<size_t, std::deque<size_t>>>
+    getSequenceMaxBothColors(MemoryBudget &budget) const;
+
+    [[nodiscard]] SequenceTable getSequences(GraphInterface::Color color) const;
+
+    // Over the budget, the table of the best sequence found so far, whose run may be below the maximum: the table
+    // then has no answer for the k it missed
+    [[nodiscard]] SequenceTable getSequences(GraphInterface::Color color, MemoryBudget &budget) const;
+
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceHeuristic(GraphInterface::Color color,
+                                                                            std::chrono::microseconds timeBudget = std::chrono::milliseconds(10)) const;
+
+    // Heuristic stopped after moveBudget moves of its local search, which always gives the same sequence
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceHeuristic(GraphInterface::Color color,
+                                                                            size_t moveBudget) const;
+
+    [[nodiscard]] std::optional<std::deque<size_t>> getSequenceExternal(GraphInterface::Color color, size_t k,
+                                                                        size_t memoryBudget,
+                                                                        const std::filesystem::path &spillDirectory = std::filesystem::temp_directory_path()) const;
+
+    // Iterative deepening search, whose memory is linear in the number of nodes apart from the transposition table
+    // (none when its capacity is 0)
+    [[nodiscard]] std::optional<std::deque<size_t>> getSequenceIdaStar(GraphInterface::Color color, size_t k,
+                                                                       size_t transpositionTableCapacity = 1 << 16) const;
+
+    // The states of the search are charged to the budget, the transposition table apart: std::nullopt as well when
+    // they do not fit, the budget being then exceeded
+    [[nodiscard]] std::optional<std::deque<size_t>> getSequenceIdaStar(GraphInterface::Color color, size_t k,
+                                                                       MemoryBudget &budget,
+                                                                       size_t transpositionTableCapacity = 1 << 16) const;
+
     [[maybe_unused]] [[nodiscard]] bool isEmpty() const;
 
     [[maybe_unused]] [[nodiscard]] size_t getMaxCapacity() const;
 
     [[maybe_unused]] [[nodiscard]] size_t size() const;
 
+    // Highest color of the nodes and edges plus one, 2 at least. The exact search, the sequence table and the
+    // heuristic are compiled for each number of colors, the other searches only run on red and blue graphs.
+    [[nodiscard]] size_t getColorCount() const;
+
+    // Bytes held by a copy of the graph, itself included. Unlike the capacities of the graph, they do not depend on
+    // its history, a search charging and releasing the same amount for a state it copied in between.
+    [[nodiscard]] size_t getMemoryUsage() const;
+
     friend std::ostream &operator<<(std::ostream &os, const Graph &graph);
 
     friend bool operator==(const Graph &g1, const Graph &g2);
 
+    friend class GraphBuilder;
+
 private:
     size_t _maxCapacity;
     size_t _size = 0;
-    std::vector<std::optional<std::unique_ptr<Node>>> _nodes;
+    std::vector<std::optional<Node>> _nodes;
 };
 
 
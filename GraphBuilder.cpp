@@ -0,0 +1,136 @@
+#include <algorithm>
+#include "GraphBuilder.h"
+#include "Node.h"
+
+namespace
+{
+    // Stable counting sort of the indices by a key below keyCount
+    template<typename Key>
+    std::vector<size_t> sortByKey(const std::vector<size_t> &indices, size_t keyCount, Key key)
+    {
+        std::vector<size_t> starts(keyCount + 1, 0);
+        for (size_t index: indices)
+        {
+            starts[key(index) + 1]++;
+        }
+        for (size_t i = 0; i < keyCount; ++i)
+        {
+            starts[i + 1] += starts[i];
+        }
+        std::vector<size_t> sorted(indices.size());
+        for (size_t index: indices)
+        {
+            sorted[starts[key(index)]++] = index;
+        }
+        return sorted;
+    }
+}
+
+GraphBuilder::GraphBuilder(size_t maxCapacity) : _maxCapacity(maxCapacity)
+{
+}
+
+std::vector<GraphInterface::BuildError> GraphBuilder::validate(const std::vector<GraphInterface::NodeEntry> &nodes,
+                                                               const std::vector<GraphInterface::EdgeEntry> &edges) const
+{
+    std::vector<GraphInterface::BuildError> errors;
+    (void) prepare(nodes, edges, errors);
+    return errors;
+}
+
+std::optional<Graph> GraphBuilder::build(const std::vector<GraphInterface::NodeEntry> &nodes,
+                                         const std::vector<GraphInterface::EdgeEntry> &edges,
+                                         std::vector<GraphInterface::BuildError> &errors) const
+{
+    errors.clear();
+    Adjacency adjacency = prepare(nodes, edges, errors);
+    if (!errors.empty())
+    {
+        return std::nullopt;
+    }
+    Graph graph(_maxCapacity);
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        if (!adjacency.colors[i].has_value())
+        {
+            continue;
+        }
+        graph._nodes[i] = Node(*adjacency.colors[i], i);
+        graph._nodes[i]->_neighbors = NeighborList(adjacency.neighbors.data() + adjacency.offsets[i],
+                                                   adjacency.neighbors.data() + adjacency.offsets[i + 1]);
+        graph._size++;
+    }
+    return graph;
+}
+
+GraphBuilder::Adjacency GraphBuilder::prepare(const std::vector<GraphInterface::NodeEntry> &nodes,
+                                              const std::vector<GraphInterface::EdgeEntry> &edges,
+                                              std::vector<GraphInterface::BuildError> &errors) const
+{
+    Adjacency adjacency;
+    adjacency.colors.resize(_maxCapacity);
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        const GraphInterface::NodeEntry &node = nodes[i];
+        if (node.id >= _maxCapacity)
+        {
+            errors.push_back({GraphInterface::BuildError::NODE, i, "Node id is out of bounds"});
+        } else if (adjacency.colors[node.id].has_value())
+        {
+            errors.push_back({GraphInterface::BuildError::NODE, i, "Node already exists"});
+        } else
+        {
+            adjacency.colors[node.id] = node.color;
+        }
+    }
+
+    size_t nodeErrorCount = errors.size();
+    std::vector<size_t> validEdges;
+    validEdges.reserve(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        const GraphInterface::EdgeEntry &edge = edges[i];
+        if (edge.from >= _maxCapacity || edge.to >= _maxCapacity || edge.from == edge.to
+            || !adjacency.colors[edge.from].has_value() || !adjacency.colors[edge.to].has_value())
+        {
+            errors.push_back({GraphInterface::BuildError::EDGE, i, "Invalid node index"});
+        } else
+        {
+            validEdges.push_back(i);
+        }
+    }
+    std::vector<size_t> byTarget = sortByKey(validEdges, _maxCapacity, [&](size_t index)
+    {
+        return edges[index].to;
+    });
+    std::vector<size_t> bySource = sortByKey(byTarget, _maxCapacity, [&](size_t index)
+    {
+        return edges[index].from;
+    });
+
+    adjacency.offsets.assign(_maxCapacity + 1, 0);
+    adjacency.neighbors.reserve(bySource.size());
+    for (size_t j = 0; j < bySource.size(); ++j)
+    {
+        const GraphInterface::EdgeEntry &edge = edges[bySource[j]];
+        if (j > 0 && edges[bySource[j - 1]].from == edge.from && edges[bySource[j - 1]].to == edge.to)
+        {
+            errors.push_back({GraphInterface::BuildError::EDGE, bySource[j], "Edge already exists"});
+            continue;
+        }
+        adjacency.neighbors.push_back(NeighborList::Neighbor{edge.to, edge.color});
+        adjacency.offsets[edge.from + 1]++;
+    }
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        adjacency.offsets[i + 1] += adjacency.offsets[i];
+    }
+
+    // The duplicates are found in the order of the sources
+    std::sort(errors.begin() + nodeErrorCount, errors.end(), [](const GraphInterface::BuildError &e1,
+                                                                const GraphInterface::BuildError &e2)
+    {
+        return e1.index < e2.index;
+    });
+    return adjacency;
+}
@@ -0,0 +1,49 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_GRAPHBUILDER_H
+#define RED_BLUE_GRAPH_SOLVER_1_GRAPHBUILDER_H
+
+#include <optional>
+#include <vector>
+#include "Graph.h"
+#include "NeighborList.h"
+
+// Builds a Graph from arrays of nodes and edges instead of one createNode or addEdge call each. The entries are checked
+// in a single pass that lists every rejected one instead of throwing at the first one, the messages being the ones of
+// the exceptions of Graph. Two stable counting sorts of the edges, by target then by source, give the neighbors of all
+// the nodes sorted in one array, where a duplicate edge follows its first occurrence; each node then copies its
+// neighbors once, with no insertion in the middle of its list and at most one allocation of their exact count.
+class GraphBuilder
+{
+public:
+    GraphBuilder() = delete;
+    explicit GraphBuilder(size_t maxCapacity);
+    GraphBuilder(const GraphBuilder &otherBuilder) = default;
+    GraphBuilder &operator=(const GraphBuilder &other) = default;
+    ~GraphBuilder() = default;
+
+    // Rejected entries, the nodes then the edges, each in the order of its array: empty when build succeeds
+    [[nodiscard]] std::vector<GraphInterface::BuildError>
+    validate(const std::vector<GraphInterface::NodeEntry> &nodes,
+             const std::vector<GraphInterface::EdgeEntry> &edges) const;
+
+    // std::nullopt when an entry is rejected, errors being the ones of validate
+    [[nodiscard]] std::optional<Graph> build(const std::vector<GraphInterface::NodeEntry> &nodes,
+                                             const std::vector<GraphInterface::EdgeEntry> &edges,
+                                             std::vector<GraphInterface::BuildError> &errors) const;
+
+private:
+    // Neighbors of the node i between offsets[i] and offsets[i + 1]
+    struct Adjacency
+    {
+        std::vector<std::optional<GraphInterface::Color>> colors;
+        std::vector<size_t> offsets;
+        std::vector<NeighborList::Neighbor> neighbors;
+    };
+
+    size_t _maxCapacity;
+
+    [[nodiscard]] Adjacency prepare(const std::vector<GraphInterface::NodeEntry> &nodes,
+                                    const std::vector<GraphInterface::EdgeEntry> &edges,
+                                    std::vector<GraphInterface::BuildError> &errors) const;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_GRAPHBUILDER_H
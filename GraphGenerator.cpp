@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include "GraphGenerator.h"
+
+namespace
+{
+    bool compareTargets(const CompactGraph::Edge &edge1, const CompactGraph::Edge &edge2)
+    {
+        return edge1.node < edge2.node;
+    }
+}
+
+GraphGenerator::GraphGenerator(uint64_t seed) : _randomGenerator(seed), _distribution(0, 1)
+{}
+
+GraphInterface::Color GraphGenerator::randomColor(double redProbability)
+{
+    return _distribution(_randomGenerator) < redProbability ? GraphInterface::Color::RED : GraphInterface::Color::BLUE;
+}
+
+std::vector<GraphInterface::Color> GraphGenerator::randomNodeColors(size_t nodeCount, double redNodeProbability)
+{
+    std::vector<GraphInterface::Color> colors(nodeCount);
+    for (GraphInterface::Color &color: colors)
+    {
+        color = randomColor(redNodeProbability);
+    }
+    return colors;
+}
+
+size_t GraphGenerator::geometricSkip(double probability)
+{
+    if (probability >= 1)
+    {
+        return 0;
+    }
+    if (probability <= 0)
+    {
+        return std::numeric_limits<size_t>::max();
+    }
+    // 1 - U is in (0, 1], so the logarithm is finite
+    double skip = std::floor(std::log(1 - _distribution(_randomGenerator)) / std::log(1 - probability));
+    return skip >= static_cast<double>(std::numeric_limits<size_t>::max()) ? std::numeric_limits<size_t>::max()
+                                                                          : static_cast<size_t>(skip);
+}
+
+void GraphGenerator::appendUniformTargets(size_t nodeCount, size_t node, size_t count, double redEdgeProbability,
+                                          std::vector<CompactGraph::Edge> &outEdges)
+{
+    // Floyd's sampling of count values among the nodeCount - 1 other nodes, the value j standing for the node j,
+    // shifted by one from node on
+    size_t first = outEdges.size();
+    size_t candidateCount = nodeCount - 1;
+    _chosen.resize(candidateCount, false);
+    for (size_t j = candidateCount - count; j < candidateCount; ++j)
+    {
+        size_t value = std::uniform_int_distribution<size_t>(0, j)(_randomGenerator);
+        if (_chosen[value])
+        {
+            value = j;
+        }
+        _chosen[value] = true;
+        outEdges.push_back(CompactGraph::Edge{static_cast<uint32_t>(value), GraphInterface::Color::BLUE});
+    }
+    std::sort(outEdges.begin() + first, outEdges.end(), compareTargets);
+    for (auto edge = outEdges.begin() + first; edge != outEdges.end(); ++edge)
+    {
+        _chosen[edge->node] = false;
+        edge->node += edge->node >= node ? 1 : 0;
+        edge->color = randomColor(redEdgeProbability);
+    }
+}
+
+CompactGraph GraphGenerator::erdosRenyi(size_t nodeCount, double edgeProbability, double redNodeProbability,
+                                        double redEdgeProbability)
+{
+    std::vector<GraphInterface::Color> colors = randomNodeColors(nodeCount, redNodeProbability);
+    std::vector<size_t> outOffsets(nodeCount + 1, 0);
+    std::vector<CompactGraph::Edge> outEdges;
+    if (nodeCount > 1)
+    {
+        // The slot s stands for the edge from s / (n - 1) to its (s % (n - 1))-th other node, so the slots come in
+        // CSR order
+        size_t candidateCount = nodeCount - 1;
+        size_t slotCount = nodeCount * candidateCount;
+        size_t node = 0;
+        for (size_t slot = geometricSkip(edgeProbability); slot < slotCount;)
+        {
+            size_t from = slot / candidateCount;
+            size_t to = slot % candidateCount;
+            to += to >= from ? 1 : 0;
+            for (; node < from; ++node)
+            {
+                outOffsets[node + 1] = outEdges.size();
+            }
+            outEdges.push_back(CompactGraph::Edge{static_cast<uint32_t>(to), randomColor(redEdgeProbability)});
+            size_t skip = geometricSkip(edgeProbability);
+            slot = skip >= slotCount - slot ? slotCount : slot + skip + 1;
+        }
+        for (; node < nodeCount; ++node)
+        {
+            outOffsets[node + 1] = outEdges.size();
+        }
+    }
+    return CompactGraph(colors, std::move(outOffsets), std::move(outEdges));
+}
+
+CompactGraph GraphGenerator::fixedOutDegree(size_t nodeCount, size_t outDegree, double redNodeProbability,
+                                            double redEdgeProbability)
+{
+    if (nodeCount == 0 ? outDegree > 0 : outDegree > nodeCount - 1)
+    {
+        throw GraphInterface::GraphModificationException("Out degree is too big");
+    }
+    std::vector<GraphInterface::Color> colors = randomNodeColors(nodeCount, redNodeProbability);
+    std::vector<size_t> outOffsets(nodeCount + 1, 0);
+    std::vector<CompactGraph::Edge> outEdges;
+    outEdges.reserve(nodeCount * outDegree);
+    for (size_t node = 0; node < nodeCount; ++node)
+    {
+        appendUniformTargets(nodeCount, node, outDegree, redEdgeProbability, outEdges);
+        outOffsets[node + 1] = outEdges.size();
+    }
+    return CompactGraph(colors, std::move(outOffsets), std::move(outEdges));
+}
+
+CompactGraph GraphGenerator::powerLaw(size_t nodeCount, double exponent, size_t minOutDegree,
+                                      double redNodeProbability, double redEdgeProbability)
+{
+    if (exponent <= 1)
+    {
+        throw GraphInterface::GraphModificationException("Power law exponent must be greater than 1");
+    }
+    std::vector<GraphInterface::Color> colors = randomNodeColors(nodeCount, redNodeProbability);
+    std::vector<size_t> outOffsets(nodeCount + 1, 0);
+    std::vector<CompactGraph::Edge> outEdges;
+    size_t maxOutDegree = nodeCount == 0 ? 0 : nodeCount - 1;
+    for (size_t node = 0; node < nodeCount; ++node)
+    {
+        // Inverse transform of a Pareto law, then rounded down
+        double degree = std::floor(static_cast<double>(minOutDegree)
+                                   * std::pow(1 - _distribution(_randomGenerator), -1 / (exponent - 1)));
+        size_t outDegree = degree >= static_cast<double>(maxOutDegree) ? maxOutDegree : static_cast<size_t>(degree);
+        appendUniformTargets(nodeCount, node, outDegree, redEdgeProbability, outEdges);
+        outOffsets[node + 1] = outEdges.size();
+    }
+    return CompactGraph(colors, std::move(outOffsets), std::move(outEdges));
+}
+
+CompactGraph GraphGenerator::dag(size_t nodeCount, double edgeProbability, double redNodeProbability,
+                                 double redEdgeProbability)
+{
+    std::vector<GraphInterface::Color> colors = randomNodeColors(nodeCount, redNodeProbability);
+    std::vector<size_t> order(nodeCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), _randomGenerator);
+    std::vector<std::pair<uint32_t, CompactGraph::Edge>> edges;
+    std::vector<size_t> outOffsets(nodeCount + 1, 0);
+    for (size_t position = 0; position + 1 < nodeCount; ++position)
+    {
+        size_t from = order[position];
+        size_t candidateCount = nodeCount - position - 1;
+        for (size_t candidate = geometricSkip(edgeProbability); candidate < candidateCount;)
+        {
+            edges.emplace_back(from, CompactGraph::Edge{static_cast<uint32_t>(order[position + 1 + candidate]),
+                                                        randomColor(redEdgeProbability)});
+            outOffsets[from + 1]++;
+            size_t skip = geometricSkip(edgeProbability);
+            candidate = skip >= candidateCount - candidate ? candidateCount : candidate + skip + 1;
+        }
+    }
+    for (size_t node = 0; node < nodeCount; ++node)
+    {
+        outOffsets[node + 1] += outOffsets[node];
+    }
+    std::vector<CompactGraph::Edge> outEdges(edges.size());
+    std::vector<size_t> positions(outOffsets.begin(), outOffsets.end() - 1);
+    for (const std::pair<uint32_t, CompactGraph::Edge> &edge: edges)
+    {
+        outEdges[positions[edge.first]++] = edge.second;
+    }
+    for (size_t node = 0; node < nodeCount; ++node)
+    {
+        std::sort(outEdges.begin() + outOffsets[node], outEdges.begin() + outOffsets[node + 1], compareTargets);
+    }
+    return CompactGraph(colors, std::move(outOffsets), std::move(outEdges));
+}
@@ -0,0 +1,56 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_GRAPHGENERATOR_H
+#define RED_BLUE_GRAPH_SOLVER_1_GRAPHGENERATOR_H
+
+#include <random>
+#include <vector>
+#include "CompactGraph.h"
+
+// Seeded random general graphs, written directly as the CSR arrays of a CompactGraph (Graph(compactGraph) gives the
+// node based graph). Every node is present, red with probability redNodeProbability, and every edge is red with
+// probability redEdgeProbability, as in FlatGraphGenerator.
+class GraphGenerator
+{
+public:
+    GraphGenerator() = delete;
+    explicit GraphGenerator(uint64_t seed);
+    GraphGenerator(const GraphGenerator &otherGenerator) = default;
+    GraphGenerator &operator=(const GraphGenerator &other) = default;
+    ~GraphGenerator() = default;
+
+    // Each of the n * (n - 1) edges exists with probability edgeProbability. The gap to the next edge is drawn from
+    // a geometric law, so the cost is linear in the number of edges rather than in n^2.
+    [[nodiscard]] CompactGraph erdosRenyi(size_t nodeCount, double edgeProbability, double redNodeProbability = 0.5,
+                                          double redEdgeProbability = 0.5);
+
+    // Each node has outDegree out-edges to distinct nodes chosen uniformly
+    [[nodiscard]] CompactGraph fixedOutDegree(size_t nodeCount, size_t outDegree, double redNodeProbability = 0.5,
+                                              double redEdgeProbability = 0.5);
+
+    // Out-degrees follow a power law of the given exponent (greater than 1) starting at minOutDegree, capped at
+    // nodeCount - 1, with targets chosen uniformly
+    [[nodiscard]] CompactGraph powerLaw(size_t nodeCount, double exponent, size_t minOutDegree = 1,
+                                        double redNodeProbability = 0.5, double redEdgeProbability = 0.5);
+
+    // Edges only go forward in a random order of the nodes, each one with probability edgeProbability
+    [[nodiscard]] CompactGraph dag(size_t nodeCount, double edgeProbability, double redNodeProbability = 0.5,
+                                   double redEdgeProbability = 0.5);
+
+private:
+    std::mt19937_64 _randomGenerator;
+    std::uniform_real_distribution<double> _distribution;
+    // Values already drawn by appendUniformTargets, all false between two calls
+    std::vector<bool> _chosen;
+
+    [[nodiscard]] GraphInterface::Color randomColor(double redProbability);
+
+    [[nodiscard]] std::vector<GraphInterface::Color> randomNodeColors(size_t nodeCount, double redNodeProbability);
+
+    // Number of candidates skipped before the next chosen one when each is chosen with probability probability
+    [[nodiscard]] size_t geometricSkip(double probability);
+
+    // Appends count distinct targets other than node, chosen uniformly, sorted
+    void appendUniformTargets(size_t nodeCount, size_t node, size_t count, double redEdgeProbability,
+                              std::vector<CompactGraph::Edge> &outEdges);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_GRAPHGENERATOR_H
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include "GraphHeuristic.h"
+
+template<size_t COLOR_COUNT>
+BasicGraphHeuristic<COLOR_COUNT>::BasicGraphHeuristic(const BasicCompactGraph<COLOR_COUNT> &graph,
+                                                      GraphInterface::Color color, uint64_t seed)
+        : _graph(graph), _color(color), _randomGenerator(seed)
+{
+    size_t maxCapacity = _graph.getMaxCapacity();
+    _present.resize(maxCapacity);
+    _goodColor.resize(maxCapacity);
+    _blocking.resize(maxCapacity);
+    _giving.resize(maxCapacity);
+    _versions.resize(maxCapacity, 0);
+    _queuedVersions.resize(maxCapacity, 0);
+}
+
+template<size_t COLOR_COUNT>
+std::vector<bool> BasicGraphHeuristic<COLOR_COUNT>::initialPrefix() const
+{
+    const State &initialState = _graph.getInitialState();
+    std::vector<bool> inPrefix(_graph.getMaxCapacity(), false);
+    for (size_t i = 0; i < _graph.getMaxCapacity(); ++i)
+    {
+        if (!_graph.nodeExists(initialState, i) || _graph.getColor(initialState, i) == _color)
+        {
+            continue;
+        }
+        long long gain = 0;
+        for (const Edge &edge: _graph.getOutEdges(i))
+        {
+            bool targetIsGood = _graph.getColor(initialState, edge.node) == _color;
+            if (edge.color == _color && !targetIsGood)
+            {
+                gain++;
+            } else if (edge.color != _color && targetIsGood)
+            {
+                gain--;
+            }
+        }
+        inPrefix[i] = gain > 0;
+    }
+    return inPrefix;
+}
+
+template<size_t COLOR_COUNT>
+void BasicGraphHeuristic<COLOR_COUNT>::paint(size_t id)
+{
+    for (const Edge &edge: _graph.getOutEdges(id))
+    {
+        size_t target = edge.node;
+        bool becomesGood = edge.color == _color;
+        if (!_present[target] || _goodColor[target] == becomesGood)
+        {
+            continue;
+        }
+        _goodColor[target] = becomesGood;
+        _versions[target]++;
+        for (const Edge &inEdge: _graph.getInEdges(target))
+        {
+            size_t painter = inEdge.node;
+            if (!_present[painter])
+            {
+                continue;
+            }
+            if (inEdge.color != _color)
+            {
+                becomesGood ? _blocking[painter]++ : _blocking[painter]--;
+            } else
+            {
+                becomesGood ? _giving[painter]-- : _giving[painter]++;
+            }
+            _versions[painter]++;
+        }
+    }
+}
+
+template<size_t COLOR_COUNT>
+size_t BasicGraphHeuristic<COLOR_COUNT>::evaluate(const std::vector<bool> &inPrefix, std::vector<uint32_t> &sequence)
+{
+    const State &initialState = _graph.getInitialState();
+    size_t maxCapacity = _graph.getMaxCapacity();
+    sequence.clear();
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        _present[i] = _graph.nodeExists(initialState, i);
+        _goodColor[i] = _present[i] && _graph.getColor(initialState, i) == _color;
+    }
+
+    // Painters giving the other color first, so that the ones giving the color have the last word
+    std::vector<uint32_t> prefix;
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        if (_present[i] && inPrefix[i])
+        {
+            prefix.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    std::stable_partition(prefix.begin(), prefix.end(), [this](uint32_t id) {
+        EdgeRange outEdges = _graph.getOutEdges(id);
+        return std::any_of(outEdges.begin(), outEdges.end(), [this](const Edge &edge) {
+            return edge.color != _color;
+        });
+    });
+    size_t run = 0;
+    for (uint32_t id: prefix)
+    {
+        run = _goodColor[id] ? run + 1 : 0;
+        _present[id] = false;
+        for (const Edge &edge: _graph.getOutEdges(id))
+        {
+            if (_present[edge.node])
+            {
+                _goodColor[edge.node] = edge.color == _color;
+            }
+        }
+        sequence.push_back(id);
+    }
+
+    std::priority_queue<RunKey, std::vector<RunKey>, RunKeyGreater> candidates;
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        if (!_present[i])
+        {
+            continue;
+        }
+        _blocking[i] = 0;
+        _giving[i] = 0;
+        for (const Edge &edge: _graph.getOutEdges(i))
+        {
+            if (!_present[edge.node])
+            {
+                continue;
+            }
+            if (edge.color != _color && _goodColor[edge.node])
+            {
+                _blocking[i]++;
+            } else if (edge.color == _color && !_goodColor[edge.node])
+            {
+                _giving[i]++;
+            }
+        }
+        if (_goodColor[i])
+        {
+            _queuedVersions[i] = _versions[i];
+            candidates.push(RunKey{_blocking[i], _giving[i], static_cast<uint32_t>(i), _versions[i]});
+        }
+    }
+
+    std::vector<uint32_t> touched;
+    while (!candidates.empty())
+    {
+        RunKey key = candidates.top();
+        candidates.pop();
+        size_t id = key.id;
+        if (!_present[id] || !_goodColor[id] || key.version != _versions[id])
+        {
+            continue;
+        }
+        _present[id] = false;
+        sequence.push_back(key.id);
+        run++;
+        for (const Edge &inEdge: _graph.getInEdges(id))
+        {
+            if (_present[inEdge.node] && inEdge.color != _color)
+            {
+                _blocking[inEdge.node]--;
+                _versions[inEdge.node]++;
+            }
+        }
+        paint(id);
+        touched.clear();
+        for (const Edge &edge: _graph.getOutEdges(id))
+        {
+            touched.push_back(edge.node);
+            for (const Edge &inEdge: _graph.getInEdges(edge.node))
+            {
+                touched.push_back(inEdge.node);
+            }
+        }
+        for (const Edge &inEdge: _graph.getInEdges(id))
+        {
+            touched.push_back(inEdge.node);
+        }
+        for (uint32_t node: touched)
+        {
+            if (_present[node] && _goodColor[node] && _queuedVersions[node] != _versions[node])
+            {
+                _queuedVersions[node] = _versions[node];
+                candidates.push(RunKey{_blocking[node], _giving[node], node, _versions[node]});
+            }
+        }
+    }
+    return run;
+}
+
+template<size_t COLOR_COUNT>
+std::pair<size_t, std::deque<size_t>> BasicGraphHeuristic<COLOR_COUNT>::solve(std::chrono::microseconds timeBudget)
+{
+    return solve(std::chrono::steady_clock::now() + timeBudget, std::numeric_limits<size_t>::max());
+}
+
+template<size_t COLOR_COUNT>
+std::pair<size_t, std::deque<size_t>> BasicGraphHeuristic<COLOR_COUNT>::solve(size_t moveBudget)
+{
+    return solve(std::chrono::steady_clock::time_point::max(), moveBudget);
+}
+
+template<size_t COLOR_COUNT>
+std::pair<size_t, std::deque<size_t>>
+BasicGraphHeuristic<COLOR_COUNT>::solve(std::chrono::steady_clock::time_point deadline, size_t moveBudget)
+{
+    const State &initialState = _graph.getInitialState();
+    std::vector<bool> inPrefix = initialPrefix();
+    std::vector<uint32_t> bestSequence, sequence;
+    size_t bestRun = evaluate(inPrefix, bestSequence);
+
+    std::vector<uint32_t> painters;
+    for (size_t i = 0; i < _graph.getMaxCapacity(); ++i)
+    {
+        if (_graph.nodeExists(initialState, i) && _graph.getOutEdges(i).size() > 0)
+        {
+            painters.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    size_t currentRun = bestRun;
+    size_t stagnation = 0;
+    std::uniform_int_distribution<size_t> painterDistribution(0, painters.empty() ? 0 : painters.size() - 1);
+    for (size_t move = 0; move < moveBudget && !painters.empty() && stagnation < 2 * painters.size() + 16
+                          && std::chrono::steady_clock::now() < deadline; ++move)
+    {
+        size_t painter = painters[painterDistribution(_randomGenerator)];
+        inPrefix[painter] = !inPrefix[painter];
+        size_t run = evaluate(inPrefix, sequence);
+        if (run < currentRun)
+        {
+            inPrefix[painter] = !inPrefix[painter];
+            stagnation++;
+            continue;
+        }
+        stagnation = run > currentRun ? 0 : stagnation + 1;
+        currentRun = run;
+        if (run > bestRun)
+        {
+            bestRun = run;
+            bestSequence.swap(sequence);
+        }
+    }
+    return std::make_pair(bestRun, std::deque<size_t>(bestSequence.begin(), bestSequence.end()));
+}
+
+template class BasicGraphHeuristic<2>;
+template class BasicGraphHeuristic<3>;
+template class BasicGraphHeuristic<4>;
@@ -0,0 +1,86 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_GRAPHHEURISTIC_H
+#define RED_BLUE_GRAPH_SOLVER_1_GRAPHHEURISTIC_H
+
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+#include "CompactGraph.h"
+
+// Polynomial heuristic for the general graph. A sequence is built as a prefix of painters (nodes removed only for
+// the colors they give) followed by a greedy run: among the nodes of the color, the ones that would give the other
+// color to a node of the color are delayed and the ones giving the color are preferred, which is the
+// FlatGraph::shouldBeRemovedBefore rule applied to every edge. A local search then flips nodes in and out of the
+// prefix while the time budget allows it. Only the nodes of the color and the others are told apart, so the heuristic
+// is the same whatever the number of colors.
+template<size_t COLOR_COUNT>
+class BasicGraphHeuristic
+{
+public:
+    BasicGraphHeuristic() = delete;
+    BasicGraphHeuristic(const BasicCompactGraph<COLOR_COUNT> &graph, GraphInterface::Color color, uint64_t seed = 0);
+    BasicGraphHeuristic(const BasicGraphHeuristic &otherHeuristic) = delete;
+    ~BasicGraphHeuristic() = default;
+
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> solve(std::chrono::microseconds timeBudget);
+
+    // Same search stopped after moveBudget moves of the local search rather than at a deadline, so that the sequence
+    // only depends on the graph and the seed
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> solve(size_t moveBudget);
+
+private:
+    using State = typename BasicCompactGraph<COLOR_COUNT>::State;
+    using Edge = typename BasicCompactGraph<COLOR_COUNT>::Edge;
+    using EdgeRange = typename BasicCompactGraph<COLOR_COUNT>::EdgeRange;
+
+    struct RunKey
+    {
+        uint32_t blocking;
+        uint32_t giving;
+        uint32_t id;
+        uint32_t version;
+    };
+
+    struct RunKeyGreater
+    {
+        bool operator()(const RunKey &k1, const RunKey &k2) const
+        {
+            if (k1.blocking != k2.blocking)
+            {
+                return k1.blocking > k2.blocking;
+            }
+            if (k1.giving != k2.giving)
+            {
+                return k1.giving < k2.giving;
+            }
+            return k1.id > k2.id;
+        }
+    };
+
+    const BasicCompactGraph<COLOR_COUNT> &_graph;
+    GraphInterface::Color _color;
+    std::mt19937_64 _randomGenerator;
+    std::vector<bool> _present;
+    std::vector<bool> _goodColor;
+    std::vector<uint32_t> _blocking;
+    std::vector<uint32_t> _giving;
+    std::vector<uint32_t> _versions;
+    std::vector<uint32_t> _queuedVersions;
+
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> solve(std::chrono::steady_clock::time_point deadline,
+                                                              size_t moveBudget);
+
+    [[nodiscard]] std::vector<bool> initialPrefix() const;
+
+    size_t evaluate(const std::vector<bool> &inPrefix, std::vector<uint32_t> &sequence);
+
+    void paint(size_t id);
+};
+
+extern template class BasicGraphHeuristic<2>;
+extern template class BasicGraphHeuristic<3>;
+extern template class BasicGraphHeuristic<4>;
+
+using GraphHeuristic = BasicGraphHeuristic<2>;
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_GRAPHHEURISTIC_H
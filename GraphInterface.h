@@ -1,7 +1,9 @@
 #ifndef RED_BLUE_GRAPH_SOLVER_1_GRAPHINTERFACE_H
 #define RED_BLUE_GRAPH_SOLVER_1_GRAPHINTERFACE_H
 
+#include <cstdint>
 #include <iostream>
+#include <string>
 #include <vector>
 #include <optional>
 #include <functional>
@@ -10,10 +12,66 @@
 class GraphInterface
 {
 public:
-    enum class Color
+    // Red and blue are the colors of the original problem, the others follow the same rule: a removed node gives
+    // each of its out-neighbors the color of the edge to it
+    enum class Color : uint8_t
     {
         RED,
-        BLUE
+        BLUE,
+        GREEN,
+        YELLOW
+    };
+
+    static constexpr size_t MAX_COLOR_COUNT = 4;
+
+    [[nodiscard]] static const char *getColorName(Color color)
+    {
+        static constexpr const char *NAMES[MAX_COLOR_COUNT] = {"RED", "BLUE", "GREEN", "YELLOW"};
+        return NAMES[static_cast<size_t>(color)];
+    }
+
+    // Color whose getColorName is name, std::nullopt for any other name
+    [[nodiscard]] static std::optional<Color> findColor(const std::string &name)
+    {
+        for (size_t i = 0; i < MAX_COLOR_COUNT; ++i)
+        {
+            if (name == getColorName(static_cast<Color>(i)))
+            {
+                return static_cast<Color>(i);
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Receives the nodes of a removal sequence one by one, in its order, as a solver removes them
+    using SequenceSink = std::function<void(size_t nodeId)>;
+
+    // Bulk input of GraphBuilder and FlatGraphBuilder: the arguments of createNode and addEdge
+    struct NodeEntry
+    {
+        size_t id;
+        Color color;
+    };
+
+    struct EdgeEntry
+    {
+        size_t from;
+        size_t to;
+        Color color;
+    };
+
+    // Entry rejected by a builder: its array, its index in it and why it was rejected
+    struct BuildError
+    {
+        enum Element : uint8_t
+        {
+            NODE,
+            EDGE
+        };
+
+        Element element;
+        size_t index;
+        const char *message;
     };
 
     class GraphModificationException : public std::exception
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <queue>
+#include "GraphKernel.h"
+#include "CompactGraph.h"
+
+GraphKernel::GraphKernel(const Graph &graph, GraphInterface::Color color) : _color(color),
+                                                                           _originalSize(graph.size()),
+                                                                           _kernel(0)
+{
+    CompactGraph compactGraph(graph);
+    size_t maxCapacity = graph.getMaxCapacity();
+    std::vector<bool> alive(maxCapacity);
+    std::vector<GraphInterface::Color> colors(maxCapacity);
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        alive[i] = graph.nodeExists(i);
+        colors[i] = compactGraph.getColor(compactGraph.getInitialState(), i);
+    }
+
+    auto aliveInDegree = [&](size_t id) {
+        CompactGraph::EdgeRange inEdges = compactGraph.getInEdges(id);
+        return std::count_if(inEdges.begin(), inEdges.end(), [&](const CompactGraph::Edge &edge) {
+            return alive[edge.node];
+        });
+    };
+    auto allEdgesOfColor = [&](CompactGraph::EdgeRange edges, bool ofColor) {
+        return std::all_of(edges.begin(), edges.end(), [&](const CompactGraph::Edge &edge) {
+            return !alive[edge.node] || (edge.color == _color) == ofColor;
+        });
+    };
+
+    std::queue<size_t> candidates;
+    std::vector<bool> queued(maxCapacity, true);
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        candidates.push(i);
+    }
+    auto requeue = [&](size_t id) {
+        if (alive[id] && !queued[id])
+        {
+            queued[id] = true;
+            candidates.push(id);
+        }
+    };
+    auto dropNode = [&](size_t id) {
+        alive[id] = false;
+        for (const CompactGraph::Edge &edge: compactGraph.getInEdges(id))
+        {
+            requeue(edge.node);
+        }
+        for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(id))
+        {
+            requeue(edge.node);
+            for (const CompactGraph::Edge &inEdge: compactGraph.getInEdges(edge.node))
+            {
+                requeue(inEdge.node);
+            }
+        }
+    };
+
+    while (!candidates.empty())
+    {
+        size_t id = candidates.front();
+        candidates.pop();
+        queued[id] = false;
+        if (!alive[id])
+        {
+            continue;
+        }
+        CompactGraph::EdgeRange inEdges = compactGraph.getInEdges(id);
+        CompactGraph::EdgeRange outEdges = compactGraph.getOutEdges(id);
+        bool goodColor = colors[id] == _color;
+        if (!goodColor && allEdgesOfColor(inEdges, false) && allEdgesOfColor(outEdges, false))
+        {
+            dropNode(id);
+            continue;
+        }
+        bool isSink = std::none_of(outEdges.begin(), outEdges.end(), [&](const CompactGraph::Edge &edge) {
+            return alive[edge.node];
+        });
+        if (goodColor && isSink && allEdgesOfColor(inEdges, true))
+        {
+            _runEnd.push_front(id);
+            dropNode(id);
+            continue;
+        }
+        bool isExclusivePainter = !isSink && aliveInDegree(id) == 0 && allEdgesOfColor(outEdges, true)
+                                  && std::all_of(outEdges.begin(), outEdges.end(), [&](const CompactGraph::Edge &edge) {
+            return !alive[edge.node] || aliveInDegree(edge.node) == 1;
+        });
+        if (isExclusivePainter)
+        {
+            for (const CompactGraph::Edge &edge: outEdges)
+            {
+                colors[edge.node] = _color;
+            }
+            (goodColor ? _runStart : _prefix).push_back(id);
+            dropNode(id);
+        }
+    }
+
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        if (alive[i])
+        {
+            _originalIds.push_back(i);
+        }
+    }
+    std::vector<size_t> kernelIds(maxCapacity);
+    _kernel = Graph(_originalIds.size());
+    for (size_t i = 0; i < _originalIds.size(); ++i)
+    {
+        kernelIds[_originalIds[i]] = i;
+        _kernel.createNode(colors[_originalIds[i]], i);
+    }
+    for (size_t i = 0; i < _originalIds.size(); ++i)
+    {
+        for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(_originalIds[i]))
+        {
+            if (alive[edge.node])
+            {
+                _kernel.addEdge(i, kernelIds[edge.node], edge.color);
+            }
+        }
+    }
+}
+
+const Graph &GraphKernel::getKernel() const
+{
+    return _kernel;
+}
+
+size_t GraphKernel::getOriginalId(size_t kernelId) const
+{
+    return _originalIds.at(kernelId);
+}
+
+size_t GraphKernel::getRemovedNodeCount() const
+{
+    return _originalSize - _kernel.size();
+}
+
+std::deque<size_t> GraphKernel::liftSequence(const std::deque<size_t> &kernelSequence, size_t kernelRun) const
+{
+    std::deque<size_t> sequence(_prefix);
+    size_t runStart = kernelSequence.size() - std::min(kernelRun, kernelSequence.size());
+    for (size_t i = 0; i < runStart; ++i)
+    {
+        sequence.push_back(_originalIds[kernelSequence[i]]);
+    }
+    sequence.insert(sequence.end(), _runStart.begin(), _runStart.end());
+    for (size_t i = runStart; i < kernelSequence.size(); ++i)
+    {
+        sequence.push_back(_originalIds[kernelSequence[i]]);
+    }
+    sequence.insert(sequence.end(), _runEnd.begin(), _runEnd.end());
+    return sequence;
+}
+
+std::optional<std::deque<size_t>> GraphKernel::getSequence(size_t k) const
+{
+    size_t bonus = _runStart.size() + _runEnd.size();
+    if (k == 0)
+    {
+        return std::deque<size_t>();
+    }
+    if (k <= bonus)
+    {
+        std::deque<size_t> sequence(_prefix);
+        sequence.insert(sequence.end(), _runStart.begin(), _runStart.end());
+        sequence.insert(sequence.end(), _runEnd.begin(), _runEnd.end());
+        sequence.resize(_prefix.size() + k);
+        return sequence;
+    }
+    std::optional<std::deque<size_t>> kernelSequence = _kernel.getSequence(_color, k - bonus);
+    if (!kernelSequence.has_value())
+    {
+        return std::nullopt;
+    }
+    return liftSequence(kernelSequence.value(), k - bonus);
+}
+
+std::pair<size_t, std::deque<size_t>> GraphKernel::getSequenceMax() const
+{
+    std::pair<size_t, std::deque<size_t>> kernelSequenceMax = _kernel.getSequenceMax(_color);
+    return std::make_pair(kernelSequenceMax.first + _runStart.size() + _runEnd.size(),
+                          liftSequence(kernelSequenceMax.second, kernelSequenceMax.first));
+}
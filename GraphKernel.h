@@ -0,0 +1,45 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_GRAPHKERNEL_H
+#define RED_BLUE_GRAPH_SOLVER_1_GRAPHKERNEL_H
+
+#include <deque>
+#include <optional>
+#include <vector>
+#include "Graph.h"
+
+// Shrinks a Graph for one color with reduction rules that keep the optimum, solves the remaining kernel with the
+// search of Graph and maps the kernel sequence back to the original ids. The rules are applied until none fires:
+//  - a node that is never of the color and only gives the other color through its edges is never worth removing,
+//  - a sink that is always of the color is removed right after the kernel run,
+//  - a source whose edges all give the color to nodes painted by no one else is removed with its painting applied:
+//    at the very beginning if it is of the other color, right before the kernel run otherwise.
+class GraphKernel
+{
+public:
+    GraphKernel() = delete;
+    GraphKernel(const Graph &graph, GraphInterface::Color color);
+    GraphKernel(const GraphKernel &otherKernel) = default;
+    ~GraphKernel() = default;
+
+    [[nodiscard]] const Graph &getKernel() const;
+
+    [[nodiscard]] size_t getOriginalId(size_t kernelId) const;
+
+    [[nodiscard]] size_t getRemovedNodeCount() const;
+
+    [[nodiscard]] std::optional<std::deque<size_t>> getSequence(size_t k) const;
+
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceMax() const;
+
+    [[nodiscard]] std::deque<size_t> liftSequence(const std::deque<size_t> &kernelSequence, size_t kernelRun) const;
+
+private:
+    GraphInterface::Color _color;
+    size_t _originalSize;
+    std::vector<size_t> _originalIds;
+    std::deque<size_t> _prefix;
+    std::deque<size_t> _runStart;
+    std::deque<size_t> _runEnd;
+    Graph _kernel;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_GRAPHKERNEL_H
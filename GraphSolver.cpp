@@ -0,0 +1,286 @@
+#include <algorithm>
+#include "GraphSolver.h"
+#include "CompactGraph.h"
+#include "IdaStarSearch.h"
+#include "FlatGraph.h"
+#include "GraphHeuristic.h"
+#include "StateSearch.h"
+
+GraphSolver::Shape GraphSolver::detectShape(const Graph &graph)
+{
+    std::vector<size_t> pathOrder;
+    if (layoutPath(graph, pathOrder))
+    {
+        return Shape::PATH;
+    }
+    if (layoutRing(graph, pathOrder))
+    {
+        return Shape::RING;
+    }
+    return buildTree(graph).has_value() ? Shape::TREE : Shape::GENERAL;
+}
+
+GraphSolver::SolveResult GraphSolver::solveMax(const Graph &graph, GraphInterface::Color color, size_t memoryBudget)
+{
+    std::vector<size_t> pathOrder;
+    if (layoutPath(graph, pathOrder))
+    {
+        return solvePath(graph, color, pathOrder);
+    }
+    if (layoutRing(graph, pathOrder))
+    {
+        return solveRing(graph, color, pathOrder);
+    }
+    std::optional<TreeGraph> treeGraph = buildTree(graph);
+    if (treeGraph.has_value())
+    {
+        std::pair<size_t, std::deque<size_t>> sequenceMax = treeGraph->getSequenceMax(color);
+        return SolveResult{Shape::TREE, sequenceMax.first, std::move(sequenceMax.second)};
+    }
+    return solveGeneral(graph, color, memoryBudget);
+}
+
+std::string GraphSolver::getShapeName(Shape shape)
+{
+    switch (shape)
+    {
+        case Shape::PATH:
+            return "PATH";
+        case Shape::RING:
+            return "RING";
+        case Shape::TREE:
+            return "TREE";
+        default:
+            return "GENERAL";
+    }
+}
+
+bool GraphSolver::layoutPath(const Graph &graph, std::vector<size_t> &pathOrder)
+{
+    CompactGraph compactGraph(graph);
+    const CompactGraph::State &initialState = compactGraph.getInitialState();
+    size_t maxCapacity = graph.getMaxCapacity();
+    std::vector<std::vector<size_t>> neighbors(maxCapacity);
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        if (!compactGraph.nodeExists(initialState, i))
+        {
+            continue;
+        }
+        for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(i))
+        {
+            neighbors[i].push_back(edge.node);
+            neighbors[edge.node].push_back(i);
+            if (neighbors[i].size() > 2 || neighbors[edge.node].size() > 2)
+            {
+                return false;
+            }
+        }
+    }
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        // An edge in each direction between the same nodes cannot be stored by a FlatGraph
+        if (neighbors[i].size() == 2 && neighbors[i][0] == neighbors[i][1])
+        {
+            return false;
+        }
+    }
+
+    pathOrder.clear();
+    std::vector<bool> visited(maxCapacity, false);
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        if (!compactGraph.nodeExists(initialState, i) || visited[i] || neighbors[i].size() == 2)
+        {
+            continue;
+        }
+        size_t previous = i, current = i;
+        while (true)
+        {
+            visited[current] = true;
+            pathOrder.push_back(current);
+            auto next = std::find_if(neighbors[current].begin(), neighbors[current].end(), [&](size_t neighbor) {
+                return neighbor != previous && !visited[neighbor];
+            });
+            if (next == neighbors[current].end())
+            {
+                break;
+            }
+            previous = current;
+            current = *next;
+        }
+    }
+    // Nodes left over all have two neighbors: they lie on cycles
+    return pathOrder.size() == graph.size();
+}
+
+bool GraphSolver::layoutRing(const Graph &graph, std::vector<size_t> &ringOrder)
+{
+    CompactGraph compactGraph(graph);
+    const CompactGraph::State &initialState = compactGraph.getInitialState();
+    size_t maxCapacity = graph.getMaxCapacity();
+    std::vector<std::vector<size_t>> neighbors(maxCapacity);
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(i))
+        {
+            neighbors[i].push_back(edge.node);
+            neighbors[edge.node].push_back(i);
+        }
+    }
+    ringOrder.clear();
+    if (graph.size() < 3)
+    {
+        return false;
+    }
+    size_t start = 0;
+    while (!compactGraph.nodeExists(initialState, start))
+    {
+        start++;
+    }
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        if (compactGraph.nodeExists(initialState, i)
+            && (neighbors[i].size() != 2 || neighbors[i][0] == neighbors[i][1]))
+        {
+            return false;
+        }
+    }
+    // Every node has two distinct neighbors: the graph is a single ring if the walk from a node visits all of them
+    size_t previous = neighbors[start][1], current = start;
+    do
+    {
+        ringOrder.push_back(current);
+        size_t next = neighbors[current][0] == previous ? neighbors[current][1] : neighbors[current][0];
+        previous = current;
+        current = next;
+    } while (current != start);
+    return ringOrder.size() == graph.size();
+}
+
+std::optional<TreeGraph> GraphSolver::buildTree(const Graph &graph)
+{
+    CompactGraph compactGraph(graph);
+    const CompactGraph::State &initialState = compactGraph.getInitialState();
+    TreeGraph treeGraph(graph.getMaxCapacity());
+    for (size_t i = 0; i < graph.getMaxCapacity(); ++i)
+    {
+        if (compactGraph.nodeExists(initialState, i))
+        {
+            treeGraph.createNode(compactGraph.getColor(initialState, i), i);
+        }
+    }
+    try
+    {
+        for (size_t i = 0; i < graph.getMaxCapacity(); ++i)
+        {
+            for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(i))
+            {
+                treeGraph.addEdge(i, edge.node, edge.color);
+            }
+        }
+    }
+    catch (const GraphInterface::GraphModificationException &)
+    {
+        // The edge closes a cycle
+        return std::nullopt;
+    }
+    return treeGraph;
+}
+
+GraphSolver::SolveResult GraphSolver::solvePath(const Graph &graph, GraphInterface::Color color,
+                                                const std::vector<size_t> &pathOrder)
+{
+    if (pathOrder.empty())
+    {
+        return SolveResult{Shape::PATH, 0, std::deque<size_t>()};
+    }
+    CompactGraph compactGraph(graph);
+    const CompactGraph::State &initialState = compactGraph.getInitialState();
+    std::vector<size_t> positions(graph.getMaxCapacity());
+    FlatGraph flatGraph(pathOrder.size());
+    for (size_t position = 0; position < pathOrder.size(); ++position)
+    {
+        positions[pathOrder[position]] = position;
+        flatGraph.createNode(compactGraph.getColor(initialState, pathOrder[position]), position);
+    }
+    for (size_t id: pathOrder)
+    {
+        for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(id))
+        {
+            flatGraph.addEdge(positions[id], positions[edge.node], edge.color);
+        }
+    }
+    std::deque<size_t> sequence = flatGraph.getSequenceMax(color);
+    for (size_t &position: sequence)
+    {
+        position = pathOrder[position];
+    }
+    return SolveResult{Shape::PATH, sequence.size(), std::move(sequence)};
+}
+
+GraphSolver::SolveResult GraphSolver::solveRing(const Graph &graph, GraphInterface::Color color,
+                                                const std::vector<size_t> &ringOrder)
+{
+    CompactGraph compactGraph(graph);
+    const CompactGraph::State &initialState = compactGraph.getInitialState();
+    std::vector<size_t> positions(graph.getMaxCapacity());
+    RingFlatGraph ringGraph(ringOrder.size());
+    for (size_t position = 0; position < ringOrder.size(); ++position)
+    {
+        positions[ringOrder[position]] = position;
+        ringGraph.createNode(compactGraph.getColor(initialState, ringOrder[position]), position);
+    }
+    for (size_t id: ringOrder)
+    {
+        for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(id))
+        {
+            ringGraph.addEdge(positions[id], positions[edge.node], edge.color);
+        }
+    }
+    std::pair<size_t, std::deque<size_t>> sequenceMax = ringGraph.getSequenceMax(color);
+    for (size_t &position: sequenceMax.second)
+    {
+        position = ringOrder[position];
+    }
+    return SolveResult{Shape::RING, sequenceMax.first, std::move(sequenceMax.second)};
+}
+
+GraphSolver::SolveResult GraphSolver::solveGeneral(const Graph &graph, GraphInterface::Color color,
+                                                   size_t memoryBudget)
+{
+    // The exact search by layers of states, seeded by a fixed number of moves of the heuristic: within the budget,
+    // its run is the maximum
+    CompactGraph compactGraph(graph);
+    MemoryBudget budget(memoryBudget);
+    StateSearch stateSearch(compactGraph, color);
+    stateSearch.setMemoryBudget(&budget);
+    GraphHeuristic heuristic(compactGraph, color);
+    std::pair<size_t, std::deque<size_t>> sequenceMax = stateSearch.solveMax(heuristic.solve(SEED_MOVE_COUNT));
+    if (!budget.isExceeded())
+    {
+        return SolveResult{Shape::GENERAL, sequenceMax.first, std::move(sequenceMax.second), Status::COMPLETE,
+                           budget.getPeak()};
+    }
+
+    // The layers are released by now: IDA* gets the whole budget to look for one more removal of the color at a
+    // time, the first run it cannot reach proving the previous one is the longest
+    IdaStarSearch search(compactGraph, color);
+    MemoryBudget depthFirstBudget(memoryBudget);
+    search.setMemoryBudget(&depthFirstBudget);
+    // The table is only an accelerator: it takes at most half of the budget, the rest going to the states of IDA*
+    std::optional<TranspositionTable> table;
+    if (TranspositionTable::getMemoryUsage(TRANSPOSITION_TABLE_CAPACITY) <= memoryBudget / 2)
+    {
+        table.emplace(TRANSPOSITION_TABLE_CAPACITY);
+        depthFirstBudget.charge(table->getMemoryUsage());
+        search.setTranspositionTable(&*table);
+    }
+    while (std::optional<std::deque<size_t>> sequence = search.getSequence(sequenceMax.first + 1))
+    {
+        sequenceMax = std::make_pair(sequenceMax.first + 1, std::move(*sequence));
+    }
+    Status status = depthFirstBudget.isExceeded() ? Status::BUDGET_EXCEEDED : Status::COMPLETE;
+    return SolveResult{Shape::GENERAL, sequenceMax.first, std::move(sequenceMax.second), status,
+                       std::max(budget.getPeak(), depthFirstBudget.getPeak())};
+}
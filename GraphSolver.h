@@ -0,0 +1,76 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_GRAPHSOLVER_H
+#define RED_BLUE_GRAPH_SOLVER_1_GRAPHSOLVER_H
+
+#include <deque>
+#include <optional>
+#include <vector>
+#include "Graph.h"
+#include "MemoryBudget.h"
+#include "RingFlatGraph.h"
+#include "TreeGraph.h"
+
+// Entry point choosing the engine from the shape of the graph: graphs whose undirected edges form disjoint paths
+// (whatever the node ids) are laid out on a FlatGraph and solved by its linear sweep, a single cycle is laid out on a
+// RingFlatGraph, forests are solved exactly by the TreeGraph dynamic programming and the others go through the exact
+// search by layers of StateSearch. Its memory can be bounded: over the budget, it gives way to IDA* from the best run
+// it found, whose memory is linear in the number of nodes, and when even IDA* does not fit, the best sequence found is
+// returned as is.
+class GraphSolver
+{
+public:
+    enum class Shape
+    {
+        PATH,
+        RING,
+        TREE,
+        GENERAL
+    };
+
+    enum class Status
+    {
+        // The search went to its end within the budget
+        COMPLETE,
+        // The search went over the memory budget and the sequence is the longest one it found
+        BUDGET_EXCEEDED
+    };
+
+    struct SolveResult
+    {
+        Shape shape;
+        size_t run;
+        std::deque<size_t> sequence;
+        Status status = Status::COMPLETE;
+        // Peak of the bytes of the search, 0 for the linear engines which only hold a copy of the graph
+        size_t peakBytes = 0;
+    };
+
+    GraphSolver() = delete;
+
+    [[nodiscard]] static Shape detectShape(const Graph &graph);
+
+    [[nodiscard]] static SolveResult solveMax(const Graph &graph, GraphInterface::Color color,
+                                              size_t memoryBudget = MemoryBudget::UNLIMITED);
+
+    [[nodiscard]] static std::string getShapeName(Shape shape);
+
+private:
+    static constexpr size_t TRANSPOSITION_TABLE_CAPACITY = 1 << 16;
+    static constexpr size_t SEED_MOVE_COUNT = 256;
+
+    [[nodiscard]] static bool layoutPath(const Graph &graph, std::vector<size_t> &pathOrder);
+
+    [[nodiscard]] static bool layoutRing(const Graph &graph, std::vector<size_t> &ringOrder);
+
+    [[nodiscard]] static std::optional<TreeGraph> buildTree(const Graph &graph);
+
+    [[nodiscard]] static SolveResult solvePath(const Graph &graph, GraphInterface::Color color,
+                                               const std::vector<size_t> &pathOrder);
+
+    [[nodiscard]] static SolveResult solveRing(const Graph &graph, GraphInterface::Color color,
+                                               const std::vector<size_t> &ringOrder);
+
+    [[nodiscard]] static SolveResult solveGeneral(const Graph &graph, GraphInterface::Color color,
+                                                  size_t memoryBudget);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_GRAPHSOLVER_H
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include "IdaStarSearch.h"
+
+IdaStarSearch::IdaStarSearch(const CompactGraph &graph, GraphInterface::Color color) : _graph(graph), _color(color)
+{}
+
+void IdaStarSearch::setTranspositionTable(TranspositionTable *table)
+{
+    _table = table;
+}
+
+std::optional<std::deque<size_t>> IdaStarSearch::getSequence(size_t k)
+{
+    _k = k;
+    _states.assign(1, _graph.getInitialState());
+    _states.front().run = 0;
+    _states.front().sequence.clear();
+    _nodeCount = _graph.size(_states.front());
+    size_t stateBytes = (_nodeCount + 1) * CompactGraph::stateBytes(_states.front());
+    if (_budget != nullptr && !_budget->tryCharge(stateBytes))
+    {
+        return std::nullopt;
+    }
+    _states.resize(_nodeCount + 1);
+    _sequence.clear();
+    std::optional<std::deque<size_t>> sequence;
+    // No sequence removes more than every node
+    for (size_t limit = k; limit <= _nodeCount;)
+    {
+        size_t nextLimit = NO_LIMIT;
+        if (search(0, limit, nextLimit))
+        {
+            sequence = _sequence;
+            break;
+        }
+        limit = nextLimit;
+    }
+    if (_budget != nullptr)
+    {
+        _budget->release(stateBytes);
+    }
+    return sequence;
+}
+
+void IdaStarSearch::setMemoryBudget(MemoryBudget *budget)
+{
+    _budget = budget;
+}
+
+size_t IdaStarSearch::getVisitedStateCount() const
+{
+    return _visitedStateCount;
+}
+
+size_t IdaStarSearch::getRunBound(const CompactGraph::State &state) const
+{
+    size_t bound = state.run;
+    for (size_t i = 0; i < _graph.getMaxCapacity(); ++i)
+    {
+        if (!_graph.nodeExists(state, i))
+        {
+            continue;
+        }
+        if (_graph.getColor(state, i) == _color)
+        {
+            bound++;
+            continue;
+        }
+        for (const CompactGraph::Edge &edge: _graph.getInEdges(i))
+        {
+            if (edge.color == _color && _graph.nodeExists(state, edge.node))
+            {
+                bound++;
+                break;
+            }
+        }
+    }
+    return bound;
+}
+
+bool IdaStarSearch::search(size_t depth, size_t limit, size_t &nextLimit)
+{
+    const CompactGraph::State &state = _states[depth];
+    _visitedStateCount++;
+    if (state.run >= _k)
+    {
+        return true;
+    }
+    if (depth + (_k - state.run) > limit)
+    {
+        nextLimit = std::min(nextLimit, depth + (_k - state.run));
+        return false;
+    }
+    uint64_t key = 0;
+    if (_table != nullptr)
+    {
+        // The entries only hold for one k and one color, which makes the table safe to share with any search
+        key = _graph.hash(state) ^ ((uint64_t(_k) << 1 | (_color == GraphInterface::Color::RED)) * 0x9E3779B97F4A7C15ull);
+        std::optional<TranspositionTable::Entry> entry = _table->probe(key);
+        if (entry.has_value() && entry->depth == DEAD)
+        {
+            return false;
+        }
+        // Failed with at least as many removals left, so it needs one more than it was given
+        if (entry.has_value() && entry->depth >= limit - depth)
+        {
+            nextLimit = std::min(nextLimit, depth + entry->depth + 1);
+            return false;
+        }
+    }
+    size_t runBound = getRunBound(state);
+    if (runBound < _k)
+    {
+        if (_table != nullptr)
+        {
+            _table->store(key, TranspositionTable::Entry{static_cast<uint16_t>(std::min<size_t>(state.run, DEAD)),
+                                                         static_cast<uint16_t>(std::min<size_t>(runBound, DEAD)),
+                                                         DEAD});
+        }
+        return false;
+    }
+
+    // The nodes of the color first, which extend the run
+    size_t childNextLimit = NO_LIMIT;
+    for (bool extendsRun: {true, false})
+    {
+        for (size_t node = 0; node < _graph.getMaxCapacity(); ++node)
+        {
+            if (!_graph.nodeExists(_states[depth], node)
+                || (_graph.getColor(_states[depth], node) == _color) != extendsRun)
+            {
+                continue;
+            }
+            CompactGraph::State &child = _states[depth + 1];
+            child.present = _states[depth].present;
+            child.planes = _states[depth].planes;
+            child.run = extendsRun ? _states[depth].run + 1 : 0;
+            _graph.removeNode(child, node);
+            _sequence.push_back(node);
+            if (search(depth + 1, limit, childNextLimit))
+            {
+                return true;
+            }
+            _sequence.pop_back();
+        }
+    }
+    nextLimit = std::min(nextLimit, childNextLimit);
+    if (_table != nullptr)
+    {
+        // The state needs at least childNextLimit - depth removals, so it fails with one less. Clamping only makes
+        // the entry weaker.
+        uint16_t searchedDepth = childNextLimit > _nodeCount ? DEAD : static_cast<uint16_t>(
+                std::min<size_t>(childNextLimit - depth - 1, DEAD - 1));
+        _table->store(key, TranspositionTable::Entry{static_cast<uint16_t>(std::min<size_t>(state.run, DEAD)),
+                                                     static_cast<uint16_t>(std::min<size_t>(runBound, DEAD)),
+                                                     searchedDepth});
+    }
+    return false;
+}
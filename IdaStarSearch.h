@@ -0,0 +1,58 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_IDASTARSEARCH_H
+#define RED_BLUE_GRAPH_SOLVER_1_IDASTARSEARCH_H
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+#include "CompactGraph.h"
+#include "MemoryBudget.h"
+#include "TranspositionTable.h"
+
+// Iterative deepening A* for getSequence(k): depth-first searches with a growing limit on the number of removals,
+// keeping one state per removal. A state needs at least k minus its run more removals, and none is worth searching
+// when its run plus the nodes that are or can still become of the color is below k. An optional transposition table
+// remembers the states whose search failed and the number of removals it was given, or that can never reach k.
+class IdaStarSearch
+{
+public:
+    IdaStarSearch() = delete;
+    IdaStarSearch(const CompactGraph &graph, GraphInterface::Color color);
+    IdaStarSearch(const IdaStarSearch &otherSearch) = delete;
+    ~IdaStarSearch() = default;
+
+    // The table may be shared with other searches of the same graph
+    void setTranspositionTable(TranspositionTable *table);
+
+    // The states of a search, one per removal, are charged to the budget while it runs
+    void setMemoryBudget(MemoryBudget *budget);
+
+    // Also std::nullopt when the states do not fit in the budget, which is then exceeded
+    [[nodiscard]] std::optional<std::deque<size_t>> getSequence(size_t k);
+
+    [[nodiscard]] size_t getVisitedStateCount() const;
+
+private:
+    static constexpr size_t NO_LIMIT = SIZE_MAX;
+    static constexpr uint16_t DEAD = UINT16_MAX;
+
+    const CompactGraph &_graph;
+    GraphInterface::Color _color;
+    TranspositionTable *_table = nullptr;
+    MemoryBudget *_budget = nullptr;
+    size_t _k = 0;
+    size_t _nodeCount = 0;
+    size_t _visitedStateCount = 0;
+    // The state after each removal of the sequence being searched
+    std::vector<CompactGraph::State> _states;
+    std::deque<size_t> _sequence;
+
+    // Run plus the nodes that are or can still become of the color
+    [[nodiscard]] size_t getRunBound(const CompactGraph::State &state) const;
+
+    // Whether the state at the depth reaches k within the limit, nextLimit being lowered to the smallest limit that
+    // would search further otherwise
+    bool search(size_t depth, size_t limit, size_t &nextLimit);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_IDASTARSEARCH_H
@@ -0,0 +1,58 @@
+#include "MemoryBudget.h"
+
+MemoryBudget::MemoryBudget(size_t limit) : _limit(limit)
+{}
+
+bool MemoryBudget::tryCharge(size_t bytes)
+{
+    size_t usage = _usage.load(std::memory_order_relaxed);
+    do
+    {
+        if (bytes > _limit - usage)
+        {
+            _exceeded.store(true, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!_usage.compare_exchange_weak(usage, usage + bytes, std::memory_order_relaxed));
+    size_t peak = _peak.load(std::memory_order_relaxed);
+    while (usage + bytes > peak && !_peak.compare_exchange_weak(peak, usage + bytes, std::memory_order_relaxed))
+    {}
+    return true;
+}
+
+void MemoryBudget::charge(size_t bytes)
+{
+    size_t usage = _usage.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (usage > _limit)
+    {
+        _exceeded.store(true, std::memory_order_relaxed);
+    }
+    size_t peak = _peak.load(std::memory_order_relaxed);
+    while (usage > peak && !_peak.compare_exchange_weak(peak, usage, std::memory_order_relaxed))
+    {}
+}
+
+void MemoryBudget::release(size_t bytes)
+{
+    _usage.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+size_t MemoryBudget::getLimit() const
+{
+    return _limit;
+}
+
+size_t MemoryBudget::getUsage() const
+{
+    return _usage.load(std::memory_order_relaxed);
+}
+
+size_t MemoryBudget::getPeak() const
+{
+    return _peak.load(std::memory_order_relaxed);
+}
+
+bool MemoryBudget::isExceeded() const
+{
+    return _exceeded.load(std::memory_order_relaxed);
+}
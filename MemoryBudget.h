@@ -0,0 +1,46 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_MEMORYBUDGET_H
+#define RED_BLUE_GRAPH_SOLVER_1_MEMORYBUDGET_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Bytes of the states held by a solve against a limit. The searches charge a state before keeping it and release it
+// once dropped, so that a search refused a charge stops growing and degrades instead of taking the whole process
+// down. The usage, its peak and whether a charge was refused are kept for the result. Shared by the threads of a
+// search.
+class MemoryBudget
+{
+public:
+    static constexpr size_t UNLIMITED = SIZE_MAX;
+
+    explicit MemoryBudget(size_t limit = UNLIMITED);
+    MemoryBudget(const MemoryBudget &otherBudget) = delete;
+    MemoryBudget &operator=(const MemoryBudget &other) = delete;
+    ~MemoryBudget() = default;
+
+    // False, with nothing charged, when the bytes would go over the limit
+    [[nodiscard]] bool tryCharge(size_t bytes);
+
+    // Counts bytes already held, even over the limit (the budget is then exceeded)
+    void charge(size_t bytes);
+
+    void release(size_t bytes);
+
+    [[nodiscard]] size_t getLimit() const;
+
+    [[nodiscard]] size_t getUsage() const;
+
+    [[nodiscard]] size_t getPeak() const;
+
+    // Whether a charge was refused
+    [[nodiscard]] bool isExceeded() const;
+
+private:
+    size_t _limit;
+    std::atomic<size_t> _usage{0};
+    std::atomic<size_t> _peak{0};
+    std::atomic<bool> _exceeded{false};
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_MEMORYBUDGET_H
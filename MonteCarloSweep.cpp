@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "MonteCarloSweep.h"
+
+void MonteCarloSweep::Statistics::add(double sample)
+{
+    _count++;
+    double delta = sample - _mean;
+    _mean += delta / static_cast<double>(_count);
+    _squaredDeviations += delta * (sample - _mean);
+}
+
+size_t MonteCarloSweep::Statistics::getCount() const
+{
+    return _count;
+}
+
+double MonteCarloSweep::Statistics::getMean() const
+{
+    return _mean;
+}
+
+double MonteCarloSweep::Statistics::getVariance() const
+{
+    return _count < 2 ? 0 : _squaredDeviations / static_cast<double>(_count - 1);
+}
+
+double MonteCarloSweep::Statistics::getHalfWidth() const
+{
+    if (_count < 2)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return Z_95 * std::sqrt(getVariance() / static_cast<double>(_count));
+}
+
+MonteCarloSweep::MonteCarloSweep(size_t cellCount, size_t estimatorCount, double targetHalfWidth, size_t trialBudget,
+                                 size_t minTrialCount) : _cellCount(cellCount), _estimatorCount(estimatorCount),
+                                                         _targetHalfWidth(targetHalfWidth),
+                                                         _trialBudget(trialBudget),
+                                                         _minTrialCount(std::max<size_t>(minTrialCount, 2)),
+                                                         _statistics(cellCount * estimatorCount)
+{}
+
+void MonteCarloSweep::run(const Trial &trial)
+{
+    for (size_t cell = 0; cell < _cellCount; ++cell)
+    {
+        runTrials(trial, cell, _minTrialCount);
+    }
+    while (_trialCount < _trialBudget)
+    {
+        std::vector<size_t> wideCells;
+        for (size_t cell = 0; cell < _cellCount; ++cell)
+        {
+            if (!isConverged(cell))
+            {
+                wideCells.push_back(cell);
+            }
+        }
+        if (wideCells.empty())
+        {
+            break;
+        }
+        std::sort(wideCells.begin(), wideCells.end(), [this](size_t cell1, size_t cell2)
+        {
+            return getWidthRatio(cell1) > getWidthRatio(cell2);
+        });
+        for (size_t cell: wideCells)
+        {
+            // The variance of a cell is not known well enough to give it more than its count at once
+            size_t count = std::min(getMissingTrialCount(cell), getStatistics(cell, 0).getCount());
+            runTrials(trial, cell, std::max<size_t>(count, 1));
+        }
+    }
+}
+
+void MonteCarloSweep::runCoupled(const CoupledTrial &trial)
+{
+    runCoupledTrials(trial, std::vector<bool>(_cellCount, true), _minTrialCount);
+    while (_trialCount < _trialBudget)
+    {
+        std::vector<bool> wideCells(_cellCount, false);
+        size_t wideCellCount = 0;
+        size_t count = SIZE_MAX;
+        for (size_t cell = 0; cell < _cellCount; ++cell)
+        {
+            if (!isConverged(cell))
+            {
+                wideCells[cell] = true;
+                wideCellCount++;
+                // The cells sharing the draws, a round stops at the first one that may converge
+                count = std::min({count, getMissingTrialCount(cell), getStatistics(cell, 0).getCount()});
+            }
+        }
+        // A draw samples all the wide cells, so there is no trial left once the budget cannot pay them all
+        if (wideCellCount == 0 || _trialCount + wideCellCount > _trialBudget)
+        {
+            break;
+        }
+        runCoupledTrials(trial, wideCells, std::max<size_t>(count, 1));
+    }
+}
+
+const MonteCarloSweep::Statistics &MonteCarloSweep::getStatistics(size_t cell, size_t estimator) const
+{
+    return _statistics[cell * _estimatorCount + estimator];
+}
+
+bool MonteCarloSweep::isConverged(size_t cell) const
+{
+    return getWidthRatio(cell) <= 1;
+}
+
+size_t MonteCarloSweep::getTrialCount() const
+{
+    return _trialCount;
+}
+
+void MonteCarloSweep::runTrials(const Trial &trial, size_t cell, size_t count)
+{
+    std::vector<double> samples(_estimatorCount);
+    for (size_t i = 0; i < count && _trialCount < _trialBudget; ++i)
+    {
+        trial(cell, samples);
+        for (size_t e = 0; e < _estimatorCount; ++e)
+        {
+            _statistics[cell * _estimatorCount + e].add(samples[e]);
+        }
+        _trialCount++;
+    }
+}
+
+void MonteCarloSweep::runCoupledTrials(const CoupledTrial &trial, const std::vector<bool> &cells, size_t count)
+{
+    size_t cellCount = std::count(cells.begin(), cells.end(), true);
+    std::vector<double> samples(_cellCount * _estimatorCount);
+    for (size_t i = 0; i < count && _trialCount + cellCount <= _trialBudget; ++i)
+    {
+        trial(cells, samples);
+        for (size_t cell = 0; cell < _cellCount; ++cell)
+        {
+            if (cells[cell])
+            {
+                for (size_t e = 0; e < _estimatorCount; ++e)
+                {
+                    _statistics[cell * _estimatorCount + e].add(samples[cell * _estimatorCount + e]);
+                }
+            }
+        }
+        _trialCount += cellCount;
+    }
+}
+
+double MonteCarloSweep::getWidthRatio(size_t cell) const
+{
+    double ratio = 0;
+    for (size_t e = 0; e < _estimatorCount; ++e)
+    {
+        ratio = std::max(ratio, getStatistics(cell, e).getHalfWidth() / _targetHalfWidth);
+    }
+    return ratio;
+}
+
+size_t MonteCarloSweep::getMissingTrialCount(size_t cell) const
+{
+    double neededCount = 0;
+    for (size_t e = 0; e < _estimatorCount; ++e)
+    {
+        double deviation = Z_95 * std::sqrt(getStatistics(cell, e).getVariance()) / _targetHalfWidth;
+        neededCount = std::max(neededCount, std::ceil(deviation * deviation));
+    }
+    size_t count = getStatistics(cell, 0).getCount();
+    return neededCount > static_cast<double>(count) ? static_cast<size_t>(neededCount) - count : 0;
+}
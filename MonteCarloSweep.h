@@ -0,0 +1,87 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_MONTECARLOSWEEP_H
+#define RED_BLUE_GRAPH_SOLVER_1_MONTECARLOSWEEP_H
+
+#include <functional>
+#include <vector>
+
+// Monte Carlo means of several estimators over the cells of a sweep. Instead of the same number of trials everywhere,
+// a cell is sampled until the confidence interval of each of its means is narrower than the target: after a few
+// trials per cell, each round gives the cells still too wide the trials their variance asks for (at most doubling
+// their count), and when the budget cannot pay them all, the widest cells are served first. In the coupled mode, a
+// trial samples all the cells still too wide from one random draw (common random numbers), so that the differences
+// between cells only carry the noise of the cells themselves.
+class MonteCarloSweep
+{
+public:
+    // Running mean and variance of the samples (Welford)
+    class Statistics
+    {
+    public:
+        void add(double sample);
+
+        [[nodiscard]] size_t getCount() const;
+
+        [[nodiscard]] double getMean() const;
+
+        [[nodiscard]] double getVariance() const;
+
+        // Half width of the 95 % confidence interval of the mean, infinite below two samples
+        [[nodiscard]] double getHalfWidth() const;
+
+    private:
+        size_t _count = 0;
+        double _mean = 0;
+        double _squaredDeviations = 0;
+    };
+
+    // Runs one trial of the cell and writes one sample per estimator
+    using Trial = std::function<void(size_t cell, std::vector<double> &samples)>;
+
+    // Runs one trial of each flagged cell from the same random draw, and writes one sample per estimator of the cell c
+    // at c * estimatorCount + e
+    using CoupledTrial = std::function<void(const std::vector<bool> &cells, std::vector<double> &samples)>;
+
+    MonteCarloSweep() = delete;
+
+    MonteCarloSweep(size_t cellCount, size_t estimatorCount, double targetHalfWidth, size_t trialBudget,
+                    size_t minTrialCount = 10);
+
+    MonteCarloSweep(const MonteCarloSweep &otherSweep) = delete;
+
+    ~MonteCarloSweep() = default;
+
+    void run(const Trial &trial);
+
+    // The budget and the trial count still count one trial per cell sampled
+    void runCoupled(const CoupledTrial &trial);
+
+    [[nodiscard]] const Statistics &getStatistics(size_t cell, size_t estimator) const;
+
+    [[nodiscard]] bool isConverged(size_t cell) const;
+
+    [[nodiscard]] size_t getTrialCount() const;
+
+private:
+    static constexpr double Z_95 = 1.959964;
+
+    size_t _cellCount;
+    size_t _estimatorCount;
+    double _targetHalfWidth;
+    size_t _trialBudget;
+    size_t _minTrialCount;
+    size_t _trialCount = 0;
+    // Statistics of the estimator e of the cell c at c * estimatorCount + e
+    std::vector<Statistics> _statistics;
+
+    void runTrials(const Trial &trial, size_t cell, size_t count);
+
+    void runCoupledTrials(const CoupledTrial &trial, const std::vector<bool> &cells, size_t count);
+
+    // Widest interval of the cell relative to the target
+    [[nodiscard]] double getWidthRatio(size_t cell) const;
+
+    // Trials still needed by the cell for its widest interval to meet the target, given its variance
+    [[nodiscard]] size_t getMissingTrialCount(size_t cell) const;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_MONTECARLOSWEEP_H
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include "NeighborList.h"
+
+NeighborList::NeighborList(const Neighbor *begin, const Neighbor *end) : _size(end - begin)
+{
+    if (_size > INLINE_CAPACITY)
+    {
+        _heap.reset(new Neighbor[_size]);
+        _capacity = _size;
+    }
+    std::copy(begin, end, data());
+}
+
+NeighborList::NeighborList(const NeighborList &otherList) : _size(otherList._size)
+{
+    if (_size > INLINE_CAPACITY)
+    {
+        _heap.reset(new Neighbor[_size]);
+        _capacity = _size;
+    }
+    std::copy(otherList.begin(), otherList.end(), data());
+}
+
+NeighborList::NeighborList(NeighborList &&otherList) noexcept : _inline(otherList._inline),
+                                                                _heap(std::move(otherList._heap)),
+                                                                _size(otherList._size),
+                                                                _capacity(otherList._capacity)
+{
+    otherList._size = 0;
+    otherList._capacity = INLINE_CAPACITY;
+}
+
+NeighborList &NeighborList::operator=(const NeighborList &otherList)
+{
+    if (this != &otherList)
+    {
+        *this = NeighborList(otherList);
+    }
+    return *this;
+}
+
+NeighborList &NeighborList::operator=(NeighborList &&otherList) noexcept
+{
+    _inline = otherList._inline;
+    _heap = std::move(otherList._heap);
+    _size = otherList._size;
+    _capacity = otherList._capacity;
+    otherList._size = 0;
+    otherList._capacity = INLINE_CAPACITY;
+    return *this;
+}
+
+bool NeighborList::insert(size_t id, GraphInterface::Color color)
+{
+    size_t index = lowerBound(id);
+    if (index < _size && data()[index].id == id)
+    {
+        return false;
+    }
+    if (_size == _capacity)
+    {
+        std::unique_ptr<Neighbor[]> heap(new Neighbor[_capacity * 2]);
+        std::copy(data(), data() + _size, heap.get());
+        _heap = std::move(heap);
+        _capacity *= 2;
+    }
+    std::copy_backward(data() + index, data() + _size, data() + _size + 1);
+    data()[index] = Neighbor{id, color};
+    _size++;
+    return true;
+}
+
+bool NeighborList::erase(size_t id)
+{
+    size_t index = lowerBound(id);
+    if (index == _size || data()[index].id != id)
+    {
+        return false;
+    }
+    std::copy(data() + index + 1, data() + _size, data() + index);
+    _size--;
+    return true;
+}
+
+const NeighborList::Neighbor *NeighborList::find(size_t id) const
+{
+    size_t index = lowerBound(id);
+    return index < _size && data()[index].id == id ? data() + index : nullptr;
+}
+
+NeighborList::Range NeighborList::getRange() const
+{
+    return Range(begin(), end());
+}
+
+const NeighborList::Neighbor *NeighborList::begin() const
+{
+    return data();
+}
+
+const NeighborList::Neighbor *NeighborList::end() const
+{
+    return data() + _size;
+}
+
+size_t NeighborList::size() const
+{
+    return _size;
+}
+
+NeighborList::Neighbor *NeighborList::data()
+{
+    return _heap ? _heap.get() : _inline.data();
+}
+
+const NeighborList::Neighbor *NeighborList::data() const
+{
+    return _heap ? _heap.get() : _inline.data();
+}
+
+size_t NeighborList::lowerBound(size_t id) const
+{
+    return std::lower_bound(begin(), end(), id, [](const Neighbor &neighbor, size_t value)
+    {
+        return neighbor.id < value;
+    }) - begin();
+}
+
+bool operator==(const NeighborList &l1, const NeighborList &l2)
+{
+    return std::equal(l1.begin(), l1.end(), l2.begin(), l2.end(), [](const NeighborList::Neighbor &n1,
+                                                                     const NeighborList::Neighbor &n2)
+    {
+        return n1.id == n2.id && n1.color == n2.color;
+    });
+}
@@ -0,0 +1,90 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_NEIGHBORLIST_H
+#define RED_BLUE_GRAPH_SOLVER_1_NEIGHBORLIST_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include "GraphInterface.h"
+
+// Out-neighbors of a node sorted by id. Most nodes have a low degree, so the first neighbors are stored in the list
+// itself and a node is copied without any allocation; the list holds no pointer into itself and can be moved freely.
+class NeighborList
+{
+public:
+    struct Neighbor
+    {
+        size_t id;
+        GraphInterface::Color color;
+    };
+
+    class Range
+    {
+    public:
+        Range(const Neighbor *begin, const Neighbor *end) : _begin(begin), _end(end)
+        {}
+
+        [[nodiscard]] const Neighbor *begin() const
+        {
+            return _begin;
+        }
+
+        [[nodiscard]] const Neighbor *end() const
+        {
+            return _end;
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return _end - _begin;
+        }
+
+    private:
+        const Neighbor *_begin;
+        const Neighbor *_end;
+    };
+
+    static constexpr size_t INLINE_CAPACITY = 4;
+
+    NeighborList() = default;
+    // Neighbors sorted by id without duplicates, held in the list or in a single allocation of their exact count
+    NeighborList(const Neighbor *begin, const Neighbor *end);
+    NeighborList(const NeighborList &otherList);
+    NeighborList(NeighborList &&otherList) noexcept;
+    ~NeighborList() = default;
+
+    NeighborList &operator=(const NeighborList &otherList);
+    NeighborList &operator=(NeighborList &&otherList) noexcept;
+
+    // False when the id is already a neighbor
+    bool insert(size_t id, GraphInterface::Color color);
+
+    // False when the id is not a neighbor
+    bool erase(size_t id);
+
+    [[nodiscard]] const Neighbor *find(size_t id) const;
+
+    [[nodiscard]] Range getRange() const;
+
+    [[nodiscard]] const Neighbor *begin() const;
+
+    [[nodiscard]] const Neighbor *end() const;
+
+    [[nodiscard]] size_t size() const;
+
+    friend bool operator==(const NeighborList &l1, const NeighborList &l2);
+
+private:
+    std::array<Neighbor, INLINE_CAPACITY> _inline{};
+    std::unique_ptr<Neighbor[]> _heap;
+    uint32_t _size = 0;
+    uint32_t _capacity = INLINE_CAPACITY;
+
+    [[nodiscard]] Neighbor *data();
+
+    [[nodiscard]] const Neighbor *data() const;
+
+    // Index of the first neighbor whose id is not below the given one
+    [[nodiscard]] size_t lowerBound(size_t id) const;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_NEIGHBORLIST_H
@@ -1,22 +1,27 @@
 #ifndef RED_BLUE_GRAPH_SOLVER_1_NODE_H
 #define RED_BLUE_GRAPH_SOLVER_1_NODE_H
 
-#include "Graph.h"
+#include "GraphInterface.h"
+#include "NeighborList.h"
 
-#include <map>
+#include <string>
 #include <utility>
 #include <iosfwd>
 #include <exception>
 
-class Graph;
-
+// Node of a Graph, stored by value in the graph: it does not know its graph, so removing a node (which recolors its
+// neighbors) is done by the graph
 class Node
 {
 public:
     Node() = delete;
-    Node(const Node&) = delete;
+    Node(const Node &otherNode) = default;
+    Node(Node &&otherNode) noexcept = default;
     ~Node() = default;
 
+    Node &operator=(const Node &otherNode) = default;
+    Node &operator=(Node &&otherNode) noexcept = default;
+
     class NodeModificationException : public std::exception
     {
     public:
@@ -34,24 +39,23 @@ public:
     };
 
 private:
-    Node(Graph *parentGraph, GraphInterface::Color color, size_t id);
-    Node(Graph *parentGraph, const Node &nodeToCopy);
+    Node(GraphInterface::Color color, size_t id);
 
-    void addNeighbor(Node *node, GraphInterface::Color verticeColor);
     void addNeighbor(size_t nodeId, GraphInterface::Color verticeColor);
     void removeNeighbor(size_t nodeId);
     void setColor(GraphInterface::Color color);
     [[nodiscard]] GraphInterface::Color getColor() const;
     [[nodiscard]] size_t getId() const;
-    void propagateColorToNeighbors();
     friend class Graph;
-    [[nodiscard]] std::map<size_t, GraphInterface::Color> getNeighbors() const;
+    template<size_t COLOR_COUNT> friend class BasicCompactGraph;
+    friend class NodeSymmetry;
+    friend class GraphBuilder;
+    [[nodiscard]] NeighborList::Range getNeighbors() const;
     friend std::ostream &operator<<(std::ostream &os, const Node &node);
     friend bool operator==(const Node &n1, const Node &n2);
     friend bool operator!=(const Node &n1, const Node &n2);
 
-    Graph &_parentGraph;
-    std::map<size_t, GraphInterface::Color> _neighbors;
+    NeighborList _neighbors;
     size_t _id;
     GraphInterface::Color _color;
 };
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <unordered_map>
+#include "NodeSymmetry.h"
+#include "Graph.h"
+#include "Node.h"
+
+namespace
+{
+    uint64_t mix(uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    enum EdgeDirection : uint64_t
+    {
+        OUT = 1,
+        IN = 2
+    };
+
+    uint64_t edgeSignature(EdgeDirection direction, GraphInterface::Color edgeColor, GraphInterface::Color otherColor)
+    {
+        return mix(direction << 16 | static_cast<uint64_t>(edgeColor) << 8 | static_cast<uint64_t>(otherColor));
+    }
+}
+
+NodeSymmetry::NodeSymmetry(const Graph &graph) : _representatives(graph.getMaxCapacity(), NO_NODE),
+                                                 _signatures(computeSignatures(graph))
+{
+    std::unordered_map<uint64_t, std::vector<uint32_t>> representativesBySignature;
+    for (size_t i = 0; i < graph.getMaxCapacity(); ++i)
+    {
+        if (!graph.nodeExists(i))
+        {
+            continue;
+        }
+        std::vector<uint32_t> &representatives = representativesBySignature[_signatures[i]];
+        auto twin = std::find_if(representatives.begin(), representatives.end(), [&](uint32_t representative)
+        {
+            return areTwins(graph, representative, i);
+        });
+        if (twin != representatives.end())
+        {
+            _representatives[i] = *twin;
+        } else
+        {
+            _representatives[i] = static_cast<uint32_t>(i);
+            representatives.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void NodeSymmetry::removeNode(const Graph &graph, size_t id)
+{
+    // The smallest node left takes the class of a removed representative
+    if (_representatives[id] == id)
+    {
+        uint32_t representative = NO_NODE;
+        for (size_t i = id + 1; i < _representatives.size(); ++i)
+        {
+            if (_representatives[i] == id)
+            {
+                representative = representative == NO_NODE ? static_cast<uint32_t>(i) : representative;
+                _representatives[i] = representative;
+            }
+        }
+    }
+    _representatives[id] = NO_NODE;
+
+    // A node whose neighborhood or color changed has another hash, and two twins of the graph left that were not
+    // twins before include such a node
+    std::vector<uint64_t> signatures = computeSignatures(graph);
+    std::vector<uint32_t> changed;
+    for (size_t i = 0; i < _representatives.size(); ++i)
+    {
+        if (_representatives[i] == i && signatures[i] != _signatures[i])
+        {
+            changed.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    _signatures = std::move(signatures);
+    for (uint32_t i: changed)
+    {
+        for (size_t representative = 0; representative < _representatives.size() && _representatives[i] == i;
+             ++representative)
+        {
+            if (representative != i && _representatives[representative] == representative
+                && _signatures[representative] == _signatures[i] && areTwins(graph, representative, i))
+            {
+                merge(representative, i);
+            }
+        }
+    }
+}
+
+bool NodeSymmetry::isRepresentative(size_t id) const
+{
+    return _representatives[id] == id;
+}
+
+size_t NodeSymmetry::getClassCount() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < _representatives.size(); ++i)
+    {
+        count += _representatives[i] == i;
+    }
+    return count;
+}
+
+size_t NodeSymmetry::getMemoryUsage() const
+{
+    return sizeof(NodeSymmetry) + _representatives.size() * sizeof(uint32_t) + _signatures.size() * sizeof(uint64_t);
+}
+
+std::vector<uint64_t> NodeSymmetry::computeSignatures(const Graph &graph)
+{
+    std::vector<uint64_t> signatures(graph.getMaxCapacity(), 0);
+    for (size_t i = 0; i < graph.getMaxCapacity(); ++i)
+    {
+        if (!graph.nodeExists(i))
+        {
+            continue;
+        }
+        const Node &node = graph.getNode(i);
+        signatures[i] += mix(static_cast<uint64_t>(node._color));
+        for (const NeighborList::Neighbor &neighbor: node._neighbors)
+        {
+            GraphInterface::Color neighborColor = graph.getNode(neighbor.id)._color;
+            signatures[i] += edgeSignature(OUT, neighbor.color, neighborColor);
+            signatures[neighbor.id] += edgeSignature(IN, neighbor.color, node._color);
+        }
+    }
+    return signatures;
+}
+
+bool NodeSymmetry::areTwins(const Graph &graph, size_t id1, size_t id2)
+{
+    const Node &node1 = graph.getNode(id1);
+    const Node &node2 = graph.getNode(id2);
+    if (node1._color != node2._color || node1._neighbors.size() != node2._neighbors.size())
+    {
+        return false;
+    }
+    // Exchanging the nodes maps the out-edges of the first one onto the ones of the second one
+    for (const NeighborList::Neighbor &neighbor: node1._neighbors)
+    {
+        const NeighborList::Neighbor *image = node2._neighbors.find(neighbor.id == id2 ? id1 : neighbor.id);
+        if (image == nullptr || image->color != neighbor.color)
+        {
+            return false;
+        }
+    }
+    // and the in-edges from the other nodes of the first one onto the ones of the second one
+    for (size_t i = 0; i < graph.getMaxCapacity(); ++i)
+    {
+        if (i == id1 || i == id2 || !graph.nodeExists(i))
+        {
+            continue;
+        }
+        const NeighborList &neighbors = graph.getNode(i)._neighbors;
+        const NeighborList::Neighbor *edge1 = neighbors.find(id1);
+        const NeighborList::Neighbor *edge2 = neighbors.find(id2);
+        if ((edge1 == nullptr) != (edge2 == nullptr) || (edge1 != nullptr && edge1->color != edge2->color))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void NodeSymmetry::merge(size_t representative1, size_t representative2)
+{
+    uint32_t kept = static_cast<uint32_t>(std::min(representative1, representative2));
+    uint32_t merged = static_cast<uint32_t>(std::max(representative1, representative2));
+    for (uint32_t &representative: _representatives)
+    {
+        if (representative == merged)
+        {
+            representative = kept;
+        }
+    }
+}
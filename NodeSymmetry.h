@@ -0,0 +1,56 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_NODESYMMETRY_H
+#define RED_BLUE_GRAPH_SOLVER_1_NODESYMMETRY_H
+
+#include <cstdint>
+#include <vector>
+
+class Graph;
+
+// Classes of interchangeable nodes of a Graph. Two nodes are twins when exchanging them maps the graph onto itself:
+// same color, same out-neighbors and in-neighbors with the same edge colors apart from each other, and the edges
+// between them, if any, going both ways with the same color. Removing one or the other leads to isomorphic graphs,
+// so a search only removes the representative of each class. Twins are an equivalence (exchanging u and w is
+// exchanging u and v, then v and w, then u and v) and stay twins when any other node is removed, both having the same
+// edge with it: removals only merge classes.
+//
+// The candidates are grouped by a hash of one round of color refinement (the color of the node and the colors of its
+// edges and of their other ends, which twins share) and checked pairwise. After a removal, only the classes whose hash
+// changed, the ones around the removed node, are checked against the others.
+class NodeSymmetry
+{
+public:
+    NodeSymmetry() = delete;
+    explicit NodeSymmetry(const Graph &graph);
+    NodeSymmetry(const NodeSymmetry &otherSymmetry) = default;
+    NodeSymmetry(NodeSymmetry &&otherSymmetry) noexcept = default;
+    NodeSymmetry &operator=(const NodeSymmetry &other) = default;
+    NodeSymmetry &operator=(NodeSymmetry &&other) noexcept = default;
+    ~NodeSymmetry() = default;
+
+    // Updates the classes once the node was removed from the graph
+    void removeNode(const Graph &graph, size_t id);
+
+    // Whether the node is the one of its class a search removes, false for a node not in the graph
+    [[nodiscard]] bool isRepresentative(size_t id) const;
+
+    [[nodiscard]] size_t getClassCount() const;
+
+    // Bytes held by a copy of the classes, as Graph::getMemoryUsage
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+private:
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+    // Representative of the class of each node, its smallest node, NO_NODE for the nodes not in the graph
+    std::vector<uint32_t> _representatives;
+    std::vector<uint64_t> _signatures;
+
+    [[nodiscard]] static std::vector<uint64_t> computeSignatures(const Graph &graph);
+
+    [[nodiscard]] static bool areTwins(const Graph &graph, size_t id1, size_t id2);
+
+    // Joins the two classes, the larger representative taking the smaller one
+    void merge(size_t representative1, size_t representative2);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_NODESYMMETRY_H
@@ -0,0 +1,679 @@
+#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include "RingFlatGraph.h"
+#include "TreeGraph.h"
+
+namespace
+{
+    enum RingCategory : uint8_t
+    {
+        FIRST_PREFIX,
+        FIRST_RUN,
+        PREFIX,
+        NOT_REMOVED,
+        RUN
+    };
+
+    // Color given by a neighbor removed before a node of the run: none, then good or bad for the levels first
+    // removed node, prefix and run. A node of the run gets the color of the highest level (of a good painter when
+    // there is one at that level, they can be ordered so that it is the last).
+    constexpr int IN_FLAG_COUNT = 7;
+    // Kind of a node: its category, the run one being split by the flag given by its left neighbor
+    constexpr int KIND_COUNT = RUN + IN_FLAG_COUNT;
+    // Whether the first removed node is already placed, and in which category, or whether a prefix node is
+    constexpr int MODE_COUNT = 4;
+    constexpr int STATE_COUNT = KIND_COUNT * MODE_COUNT;
+    constexpr int MAX_TRANSITIONS = RUN + 2;
+    constexpr int32_t IMPOSSIBLE = std::numeric_limits<int32_t>::min() / 4;
+
+    RingCategory kindCategory(int kind)
+    {
+        return kind < RUN ? static_cast<RingCategory>(kind) : RUN;
+    }
+
+    int kindInFlag(int kind)
+    {
+        return kind < RUN ? 0 : kind - RUN;
+    }
+
+    int flagLevel(int flag)
+    {
+        return (flag + 1) / 2;
+    }
+
+    bool isRunCategory(RingCategory category)
+    {
+        return category == RUN || category == FIRST_RUN;
+    }
+
+    int givenFlag(RingCategory category, bool removedBefore, bool good)
+    {
+        switch (category)
+        {
+            case FIRST_PREFIX:
+            case FIRST_RUN:
+                return good ? 1 : 2;
+            case PREFIX:
+                return good ? 3 : 4;
+            case RUN:
+                return removedBefore ? (good ? 5 : 6) : 0;
+            default:
+                return 0;
+        }
+    }
+
+    bool isGoodAtRemoval(int flag1, int flag2, bool initiallyGood)
+    {
+        int level = std::max(flagLevel(flag1), flagLevel(flag2));
+        if (level == 0)
+        {
+            return initiallyGood;
+        }
+        return (flagLevel(flag1) == level && flag1 % 2 == 1) || (flagLevel(flag2) == level && flag2 % 2 == 1);
+    }
+
+    int nextMode(int mode, RingCategory category)
+    {
+        switch (category)
+        {
+            case PREFIX:
+                return mode == 3 ? -1 : std::max(mode, 1);
+            case FIRST_PREFIX:
+                return mode <= 1 ? 2 : -1;
+            case FIRST_RUN:
+                return mode == 0 ? 3 : -1;
+            default:
+                return mode;
+        }
+    }
+
+    struct KindTransition
+    {
+        uint8_t kind;
+        bool leftFirst;
+    };
+
+    struct TransitionTable
+    {
+        std::array<uint8_t, KIND_COUNT> counts{};
+        std::array<std::array<KindTransition, MAX_TRANSITIONS>, KIND_COUNT> transitions{};
+    };
+
+    // Transitions from the kind of a node to the kind of its right neighbor. The verdict of a node of the run is
+    // checked once its right neighbor is known, or replaced by the flag the right neighbor must give for the node 0.
+    TransitionTable buildTransitionTable(bool edgeToRight, bool edgeGood, bool leftInitiallyGood,
+                                         int requiredLeftFlag = -1)
+    {
+        TransitionTable table;
+        for (int leftKind = 0; leftKind < KIND_COUNT; ++leftKind)
+        {
+            RingCategory leftCategory = kindCategory(leftKind);
+            // Nothing is removed before the first node
+            if (leftCategory == FIRST_RUN && !leftInitiallyGood)
+            {
+                continue;
+            }
+            for (int right = 0; right <= RUN; ++right)
+            {
+                RingCategory rightCategory = static_cast<RingCategory>(right);
+                bool bothRun = isRunCategory(leftCategory) && isRunCategory(rightCategory);
+                for (bool leftFirst: {true, false})
+                {
+                    // The order only matters between two nodes of the run, and the first removed node is first
+                    if ((!bothRun && !leftFirst) || (leftCategory == FIRST_RUN && !leftFirst)
+                        || (rightCategory == FIRST_RUN && leftFirst && isRunCategory(leftCategory)))
+                    {
+                        continue;
+                    }
+                    int rightIn = rightCategory == RUN && edgeToRight ? givenFlag(leftCategory, leftFirst, edgeGood)
+                                                                      : 0;
+                    int leftIn = !edgeToRight ? givenFlag(rightCategory, !leftFirst, edgeGood) : 0;
+                    if (leftCategory == RUN)
+                    {
+                        bool valid = requiredLeftFlag >= 0 ? leftIn == requiredLeftFlag
+                                                           : isGoodAtRemoval(kindInFlag(leftKind), leftIn,
+                                                                             leftInitiallyGood);
+                        if (!valid)
+                        {
+                            continue;
+                        }
+                    }
+                    uint8_t rightKind = static_cast<uint8_t>(rightCategory == RUN ? RUN + rightIn : rightCategory);
+                    table.transitions[leftKind][table.counts[leftKind]++] = KindTransition{rightKind, leftFirst};
+                }
+            }
+        }
+        return table;
+    }
+
+    struct RingPass
+    {
+        RingCategory category;
+        int rightFlag;
+    };
+
+    struct StateTransition
+    {
+        uint8_t state;
+        uint8_t nextState;
+        uint8_t gain;
+        bool leftFirst;
+    };
+
+    // States (kind and mode) that some ring can reach, the others are left out of the transitions
+    std::array<bool, STATE_COUNT> findReachableStates()
+    {
+        std::array<bool, STATE_COUNT> reachable{};
+        std::vector<int> pending;
+        for (int category = 0; category <= RUN; ++category)
+        {
+            int state = nextMode(0, static_cast<RingCategory>(category)) * KIND_COUNT + category;
+            reachable[state] = true;
+            pending.push_back(state);
+        }
+        while (!pending.empty())
+        {
+            int state = pending.back();
+            pending.pop_back();
+            int mode = state / KIND_COUNT;
+            for (int variant = 0; variant < 8; ++variant)
+            {
+                for (int requiredLeftFlag = -1; requiredLeftFlag < IN_FLAG_COUNT; ++requiredLeftFlag)
+                {
+                    TransitionTable table = buildTransitionTable(variant & 4, variant & 2, variant & 1,
+                                                                 requiredLeftFlag);
+                    for (int t = 0; t < table.counts[state % KIND_COUNT]; ++t)
+                    {
+                        const KindTransition &transition = table.transitions[state % KIND_COUNT][t];
+                        int nextStateMode = nextMode(mode, kindCategory(transition.kind));
+                        int nextState = nextStateMode * KIND_COUNT + transition.kind;
+                        if (nextStateMode >= 0 && !reachable[nextState])
+                        {
+                            reachable[nextState] = true;
+                            pending.push_back(nextState);
+                        }
+                    }
+                }
+            }
+        }
+        return reachable;
+    }
+
+    // Transitions between the states of two neighbors
+    std::vector<StateTransition> buildStateTransitions(const TransitionTable &table)
+    {
+        static const std::array<bool, STATE_COUNT> REACHABLE_STATES = findReachableStates();
+        std::vector<StateTransition> transitions;
+        for (int mode = 0; mode < MODE_COUNT; ++mode)
+        {
+            for (int kind = 0; kind < KIND_COUNT; ++kind)
+            {
+                if (!REACHABLE_STATES[mode * KIND_COUNT + kind])
+                {
+                    continue;
+                }
+                for (int t = 0; t < table.counts[kind]; ++t)
+                {
+                    const KindTransition &transition = table.transitions[kind][t];
+                    RingCategory category = kindCategory(transition.kind);
+                    int nextStateMode = nextMode(mode, category);
+                    if (nextStateMode >= 0)
+                    {
+                        transitions.push_back(StateTransition{static_cast<uint8_t>(mode * KIND_COUNT + kind),
+                                                              static_cast<uint8_t>(nextStateMode * KIND_COUNT
+                                                                                   + transition.kind),
+                                                              static_cast<uint8_t>(isRunCategory(category)),
+                                                              transition.leftFirst});
+                    }
+                }
+            }
+        }
+        return transitions;
+    }
+
+    // Dynamic programming over the nodes 0 to n - 1 of the ring for a given role of the node 0. The variant of a node
+    // packs the direction and the color of its right edge with its own color.
+    class RingSweep
+    {
+    public:
+        RingSweep(const std::vector<uint8_t> &variants, RingPass pass) : _variants(variants), _pass(pass)
+        {
+            for (int variant = 0; variant < VARIANT_COUNT; ++variant)
+            {
+                _tables[variant] = buildTransitionTable(variant & 4, variant & 2, variant & 1);
+                _transitions[variant] = buildStateTransitions(_tables[variant]);
+            }
+            uint8_t firstVariant = _variants[0];
+            _firstTransitions = buildStateTransitions(buildTransitionTable(firstVariant & 4, firstVariant & 2,
+                                                                           firstVariant & 1,
+                                                                           pass.category == RUN ? pass.rightFlag
+                                                                                                : -1));
+        }
+
+        void initialize(std::array<int32_t, STATE_COUNT> &values) const
+        {
+            values.fill(IMPOSSIBLE);
+            int kind = _pass.category == RUN ? RUN : _pass.category;
+            values[nextMode(0, _pass.category) * KIND_COUNT + kind] = isRunCategory(_pass.category) ? 1 : 0;
+        }
+
+        // Values of the node id + 1 from the values of the node id
+        void advance(size_t id, const std::array<int32_t, STATE_COUNT> &values,
+                     std::array<int32_t, STATE_COUNT> &nextValues, uint8_t *backPointers) const
+        {
+            const std::vector<StateTransition> &transitions = id == 0 ? _firstTransitions
+                                                                      : _transitions[_variants[id]];
+            nextValues.fill(IMPOSSIBLE);
+            for (const StateTransition &transition: transitions)
+            {
+                int32_t value = values[transition.state] + transition.gain;
+                if (value > nextValues[transition.nextState])
+                {
+                    nextValues[transition.nextState] = value;
+                    if (backPointers != nullptr)
+                    {
+                        backPointers[transition.nextState] = static_cast<uint8_t>(transition.state
+                                                                                  | (transition.leftFirst << 7));
+                    }
+                }
+            }
+        }
+
+        // Best value once the last node is linked back to the node 0, with the state of the last node and the order
+        // on the last edge
+        [[nodiscard]] std::pair<int32_t, uint8_t> close(const std::array<int32_t, STATE_COUNT> &values) const
+        {
+            const TransitionTable &table = _tables[_variants.back()];
+            std::pair<int32_t, uint8_t> best(IMPOSSIBLE, 0);
+            for (int mode = 2; mode < MODE_COUNT; ++mode)
+            {
+                for (int kind = 0; kind < KIND_COUNT; ++kind)
+                {
+                    int state = mode * KIND_COUNT + kind;
+                    if (values[state] <= best.first)
+                    {
+                        continue;
+                    }
+                    for (int t = 0; t < table.counts[kind]; ++t)
+                    {
+                        const KindTransition &transition = table.transitions[kind][t];
+                        if (kindCategory(transition.kind) != _pass.category)
+                        {
+                            continue;
+                        }
+                        if (_pass.category == RUN
+                            && !isGoodAtRemoval(kindInFlag(transition.kind), _pass.rightFlag, _variants[0] & 1))
+                        {
+                            continue;
+                        }
+                        best = std::make_pair(values[state], static_cast<uint8_t>(state | (transition.leftFirst << 7)));
+                        break;
+                    }
+                }
+            }
+            return best;
+        }
+
+    private:
+        static constexpr int VARIANT_COUNT = 8;
+
+        const std::vector<uint8_t> &_variants;
+        RingPass _pass;
+        std::array<TransitionTable, VARIANT_COUNT> _tables;
+        std::array<std::vector<StateTransition>, VARIANT_COUNT> _transitions;
+        std::vector<StateTransition> _firstTransitions;
+    };
+}
+
+RingFlatGraph::RingFlatGraph(size_t maxCapacity) : _maxCapacity(maxCapacity)
+{
+    if (maxCapacity < 3)
+    {
+        throw GraphInterface::GraphModificationException("Max capacity is too small.");
+    }
+    if (maxCapacity >= std::numeric_limits<uint32_t>::max())
+    {
+        throw GraphInterface::GraphModificationException("Max capacity is too big.");
+    }
+    _nodes.resize(maxCapacity);
+    _edges.resize(maxCapacity);
+}
+
+bool RingFlatGraph::nodeExists(size_t id) const
+{
+    return id < _maxCapacity && _nodes[id].has_value();
+}
+
+bool RingFlatGraph::edgeExists(size_t id) const
+{
+    return id < _maxCapacity && _edges[id].has_value();
+}
+
+size_t RingFlatGraph::next(size_t id) const
+{
+    return id + 1 == _maxCapacity ? 0 : id + 1;
+}
+
+size_t RingFlatGraph::previous(size_t id) const
+{
+    return id == 0 ? _maxCapacity - 1 : id - 1;
+}
+
+size_t RingFlatGraph::getMaxCapacity() const
+{
+    return _maxCapacity;
+}
+
+void RingFlatGraph::createNode(const GraphInterface::Color &color, size_t id)
+{
+    if (id >= _maxCapacity)
+    {
+        throw GraphInterface::GraphModificationException("Node id is too big.");
+    }
+    if (nodeExists(id))
+    {
+        throw GraphInterface::GraphModificationException("Node already exists.");
+    }
+    _nodes[id] = RingFlatGraphNode{color};
+    _size++;
+}
+
+bool RingFlatGraph::isEmpty() const
+{
+    return _size == 0;
+}
+
+size_t RingFlatGraph::size() const
+{
+    return _size;
+}
+
+void RingFlatGraph::addEdge(size_t from, size_t to, const GraphInterface::Color &color)
+{
+    if (!nodeExists(from) || !nodeExists(to))
+    {
+        throw GraphInterface::GraphModificationException("Node does not exist.");
+    }
+    if (next(from) != to && next(to) != from)
+    {
+        throw GraphInterface::GraphModificationException("Nodes are not adjacent.");
+    }
+    bool isLeft = next(to) == from;
+    size_t edgeId = isLeft ? to : from;
+    if (_edges[edgeId].has_value())
+    {
+        throw GraphInterface::GraphModificationException("Edge already exists.");
+    }
+    _edges[edgeId] = RingFlatGraphEdge{color, isLeft};
+}
+
+std::vector<std::pair<GraphInterface::Color, size_t>> RingFlatGraph::getNodeNeighbors(size_t nodeId) const
+{
+    if (!nodeExists(nodeId))
+    {
+        throw GraphInterface::GraphModificationException("Node does not exist.");
+    }
+    std::vector<std::pair<GraphInterface::Color, size_t>> neighbors;
+    if (nodeExists(next(nodeId)) && edgeExists(nodeId) && !_edges[nodeId]->isLeft)
+    {
+        neighbors.emplace_back(_edges[nodeId]->color, next(nodeId));
+    }
+    size_t leftEdgeId = previous(nodeId);
+    if (nodeExists(previous(nodeId)) && edgeExists(leftEdgeId) && _edges[leftEdgeId]->isLeft)
+    {
+        neighbors.emplace_back(_edges[leftEdgeId]->color, previous(nodeId));
+    }
+    return neighbors;
+}
+
+void RingFlatGraph::removeNode(size_t nodeId)
+{
+    for (const std::pair<GraphInterface::Color, size_t> &neighbor: getNodeNeighbors(nodeId))
+    {
+        _nodes[neighbor.second]->color = neighbor.first;
+    }
+    _edges[previous(nodeId)] = std::nullopt;
+    _edges[nodeId] = std::nullopt;
+    _nodes[nodeId] = std::nullopt;
+    _size--;
+}
+
+std::pair<size_t, std::deque<size_t>> RingFlatGraph::getSequenceMax(const GraphInterface::Color &color) const
+{
+    bool isRing = std::all_of(_edges.begin(), _edges.end(), [](const std::optional<RingFlatGraphEdge> &edge) {
+        return edge.has_value();
+    });
+    if (isRing)
+    {
+        return getSequenceMaxRing(color);
+    }
+    // Without one of its edges the ring is a forest
+    TreeGraph treeGraph(_maxCapacity);
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        if (nodeExists(i))
+        {
+            treeGraph.createNode(_nodes[i]->color, i);
+        }
+    }
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        if (edgeExists(i))
+        {
+            size_t from = _edges[i]->isLeft ? next(i) : i;
+            size_t to = _edges[i]->isLeft ? i : next(i);
+            treeGraph.addEdge(from, to, _edges[i]->color);
+        }
+    }
+    return treeGraph.getSequenceMax(color);
+}
+
+std::pair<size_t, std::deque<size_t>> RingFlatGraph::getSequenceMaxRing(const GraphInterface::Color &color) const
+{
+    size_t n = _maxCapacity;
+    std::vector<bool> edgesToRight(n), edgesGood(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        edgesToRight[i] = !_edges[i]->isLeft;
+        edgesGood[i] = _edges[i]->color == color;
+    }
+    // The sweep starts on a node whose right edge leaves it when there is one, so that its right neighbor gives it
+    // nothing and fewer roles have to be tried for it
+    size_t start = std::find(edgesToRight.begin(), edgesToRight.end(), true) - edgesToRight.begin();
+    start = start == n ? 0 : start;
+    std::vector<uint8_t> variants(n);
+    for (size_t position = 0; position < n; ++position)
+    {
+        size_t id = (start + position) % n;
+        variants[position] = (edgesToRight[id] ? 4 : 0) + (edgesGood[id] ? 2 : 0)
+                             + (_nodes[id]->color == color ? 1 : 0);
+    }
+
+    // Roles of the first node, with the flag given by its right neighbor when it is in the run. The values are kept
+    // every blockSize nodes to rebuild the back pointers of the best pass block by block.
+    std::vector<RingPass> passes = {{FIRST_PREFIX, -1}, {FIRST_RUN, -1}, {PREFIX, -1}, {NOT_REMOVED, -1}, {RUN, 0}};
+    if (!edgesToRight[start])
+    {
+        for (RingCategory category: {FIRST_PREFIX, PREFIX, RUN})
+        {
+            passes.push_back(RingPass{RUN, givenFlag(category, true, edgesGood[start])});
+        }
+    }
+    size_t blockSize = std::max<size_t>(1, static_cast<size_t>(std::sqrt(static_cast<double>(n))));
+    int32_t bestValue = 0;
+    std::optional<RingPass> bestPass;
+    uint8_t closing = 0;
+    std::vector<std::array<int32_t, STATE_COUNT>> checkpoints, bestCheckpoints;
+    std::array<int32_t, STATE_COUNT> values{}, nextValues{};
+    for (const RingPass &pass: passes)
+    {
+        RingSweep sweep(variants, pass);
+        checkpoints.clear();
+        sweep.initialize(values);
+        for (size_t i = 0; i + 1 < n; ++i)
+        {
+            if (i % blockSize == 0)
+            {
+                checkpoints.push_back(values);
+            }
+            sweep.advance(i, values, nextValues, nullptr);
+            values.swap(nextValues);
+        }
+        std::pair<int32_t, uint8_t> closed = sweep.close(values);
+        if (closed.first > bestValue)
+        {
+            bestValue = closed.first;
+            bestPass = pass;
+            closing = closed.second;
+            bestCheckpoints.swap(checkpoints);
+        }
+    }
+    if (!bestPass.has_value())
+    {
+        return std::make_pair(0, std::deque<size_t>());
+    }
+
+    RingSweep sweep(variants, bestPass.value());
+    std::vector<RingCategory> positionCategories(n);
+    std::vector<bool> positionLeftFirst(n, true);
+    positionCategories[0] = bestPass->category;
+    positionLeftFirst[n - 1] = closing >> 7;
+    int state = closing & 0x7F;
+    std::vector<std::array<uint8_t, STATE_COUNT>> backPointers(blockSize);
+    for (size_t block = bestCheckpoints.size(); block-- > 0;)
+    {
+        size_t begin = block * blockSize;
+        size_t end = std::min(begin + blockSize, n - 1);
+        values = bestCheckpoints[block];
+        for (size_t i = begin; i < end; ++i)
+        {
+            sweep.advance(i, values, nextValues, backPointers[i - begin].data());
+            values.swap(nextValues);
+        }
+        for (size_t i = end; i > begin; --i)
+        {
+            positionCategories[i] = kindCategory(state % KIND_COUNT);
+            uint8_t backPointer = backPointers[i - 1 - begin][state];
+            positionLeftFirst[i - 1] = backPointer >> 7;
+            state = backPointer & 0x7F;
+        }
+    }
+    std::vector<RingCategory> categories(n);
+    std::vector<bool> leftFirst(n);
+    for (size_t position = 0; position < n; ++position)
+    {
+        categories[(start + position) % n] = positionCategories[position];
+        leftFirst[(start + position) % n] = positionLeftFirst[position];
+    }
+
+    // Removal order: the first removed node, then prefix nodes and run nodes, each level in a topological order of
+    // the constraints "removed before" of the run edges and of the painters that must be the last ones
+    auto levelOf = [&](size_t id) {
+        switch (categories[id])
+        {
+            case FIRST_PREFIX:
+            case FIRST_RUN:
+                return 1;
+            case PREFIX:
+                return 2;
+            case RUN:
+                return 3;
+            default:
+                return 0;
+        }
+    };
+    std::vector<std::pair<uint32_t, uint32_t>> constraints;
+    size_t first = n;
+    for (size_t id = 0; id < n; ++id)
+    {
+        if (categories[id] == FIRST_PREFIX || categories[id] == FIRST_RUN)
+        {
+            first = id;
+        }
+        if (categories[id] != RUN)
+        {
+            continue;
+        }
+        size_t left = previous(id), right = next(id);
+        if (categories[right] == RUN)
+        {
+            leftFirst[id] ? constraints.emplace_back(id, right) : constraints.emplace_back(right, id);
+        }
+        bool leftIsEarlier = edgesToRight[left] && levelOf(left) > 0 && (categories[left] != RUN || leftFirst[left]);
+        bool rightIsEarlier = !edgesToRight[id] && levelOf(right) > 0 && (categories[right] != RUN || !leftFirst[id]);
+        if (leftIsEarlier && rightIsEarlier && levelOf(left) == levelOf(right) && edgesGood[left] != edgesGood[id])
+        {
+            edgesGood[left] ? constraints.emplace_back(right, left) : constraints.emplace_back(left, right);
+        }
+    }
+    std::vector<std::vector<uint32_t>> successors(n);
+    std::vector<uint32_t> pendingCounts(n, 0);
+    for (const std::pair<uint32_t, uint32_t> &constraint: constraints)
+    {
+        successors[constraint.first].push_back(constraint.second);
+        pendingCounts[constraint.second]++;
+    }
+    std::deque<size_t> sequence;
+    if (first < n)
+    {
+        sequence.push_back(first);
+    }
+    for (RingCategory category: {PREFIX, RUN})
+    {
+        std::vector<uint32_t> ready;
+        for (size_t id = 0; id < n; ++id)
+        {
+            if (categories[id] == category && pendingCounts[id] == 0)
+            {
+                ready.push_back(static_cast<uint32_t>(id));
+            }
+        }
+        while (!ready.empty())
+        {
+            uint32_t id = ready.back();
+            ready.pop_back();
+            sequence.push_back(id);
+            for (uint32_t successor: successors[id])
+            {
+                if (--pendingCounts[successor] == 0)
+                {
+                    ready.push_back(successor);
+                }
+            }
+        }
+    }
+    return std::make_pair(static_cast<size_t>(bestValue), sequence);
+}
+
+std::ostream &operator<<(std::ostream &os, const RingFlatGraph &graph)
+{
+    for (size_t i = 0; i < graph._maxCapacity; i++)
+    {
+        if (graph._nodes[i].has_value())
+        {
+            os << "[" << GraphInterface::getColorName(graph._nodes[i].value().color) << "]";
+        } else
+        {
+            os << "   ";
+        }
+        if (graph._edges[i].has_value())
+        {
+            const RingFlatGraph::RingFlatGraphEdge &edge = graph._edges[i].value();
+            std::string edgeColor = GraphInterface::getColorName(edge.color);
+            if (edge.isLeft)
+            {
+                os << "<-" << edgeColor << "-";
+            } else
+            {
+                os << "-" << edgeColor << "->";
+            }
+        } else
+        {
+            os << "   ";
+        }
+    }
+    return os;
+}
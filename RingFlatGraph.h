@@ -0,0 +1,68 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_RINGFLATGRAPH_H
+#define RED_BLUE_GRAPH_SOLVER_1_RINGFLATGRAPH_H
+
+#include <deque>
+#include <optional>
+#include <vector>
+#include "GraphInterface.h"
+
+// FlatGraph closed into a ring: the edge of id i links the node i and the node (i + 1) % maxCapacity, so the last
+// edge links the last node back to the node 0. As soon as an edge is missing the graph is a forest and is solved by
+// TreeGraph. A complete ring is broken on the removal order instead: the first removed node is given a category of
+// its own (its colors are overridden by any other painter), which rules out the cyclic orders, and the ring is swept
+// by a linear dynamic programming once for each role of the node 0.
+class RingFlatGraph : public GraphInterface
+{
+public:
+    RingFlatGraph() = delete;
+    explicit RingFlatGraph(size_t maxCapacity);
+    RingFlatGraph(const RingFlatGraph &otherGraph) = default;
+    RingFlatGraph &operator=(const RingFlatGraph &other) = default;
+    ~RingFlatGraph() = default;
+
+    [[nodiscard]] bool nodeExists(size_t id) const;
+
+    [[nodiscard]] size_t getMaxCapacity() const;
+
+    void createNode(const GraphInterface::Color &color, size_t id);
+
+    [[nodiscard]] bool isEmpty() const;
+
+    [[nodiscard]] size_t size() const;
+
+    void addEdge(size_t from, size_t to, const GraphInterface::Color &color);
+
+    [[nodiscard]] std::vector<std::pair<GraphInterface::Color, size_t>> getNodeNeighbors(size_t nodeId) const;
+
+    void removeNode(size_t nodeId);
+
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceMax(const GraphInterface::Color &color) const;
+
+    friend std::ostream &operator<<(std::ostream &os, const RingFlatGraph &graph);
+
+private:
+    struct RingFlatGraphNode
+    {
+        GraphInterface::Color color;
+    };
+    struct RingFlatGraphEdge
+    {
+        GraphInterface::Color color;
+        bool isLeft;
+    };
+
+    size_t _maxCapacity;
+    size_t _size = 0;
+    std::vector<std::optional<RingFlatGraphNode>> _nodes;
+    std::vector<std::optional<RingFlatGraphEdge>> _edges;
+
+    [[nodiscard]] bool edgeExists(size_t id) const;
+
+    [[nodiscard]] size_t next(size_t id) const;
+
+    [[nodiscard]] size_t previous(size_t id) const;
+
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceMaxRing(const GraphInterface::Color &color) const;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_RINGFLATGRAPH_H
@@ -0,0 +1,85 @@
+#include <fstream>
+#include <sstream>
+#include "SequenceCache.h"
+#include "CompactGraph.h"
+
+namespace
+{
+    // Hash of the compact graph holding the colors of graph, which only takes 2 to 4 of them
+    uint64_t getGraphHash(const Graph &graph)
+    {
+        switch (graph.getColorCount())
+        {
+            case 2:
+                return BasicCompactGraph<2>(graph).getGraphHash();
+            case 3:
+                return BasicCompactGraph<3>(graph).getGraphHash();
+            case 4:
+                return BasicCompactGraph<4>(graph).getGraphHash();
+            default:
+                throw GraphInterface::GraphModificationException("Color out of range");
+        }
+    }
+}
+
+SequenceCache::SequenceCache(std::filesystem::path path) : _path(std::move(path))
+{
+    std::ifstream stream(_path);
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        std::istringstream lineStream(line);
+        uint64_t hash;
+        std::string colorName;
+        size_t maxRun, sequenceSize;
+        std::optional<GraphInterface::Color> color;
+        if (lineStream >> std::hex >> hash >> std::dec >> colorName >> maxRun >> sequenceSize)
+        {
+            color = GraphInterface::findColor(colorName);
+        }
+        if (!color.has_value() || maxRun > sequenceSize)
+        {
+            // Line cut by an interrupted write
+            break;
+        }
+        std::deque<size_t> sequence(sequenceSize);
+        for (size_t &id: sequence)
+        {
+            lineStream >> id;
+        }
+        if (!lineStream)
+        {
+            break;
+        }
+        _tables.insert_or_assign(std::make_pair(hash, *color), SequenceTable(maxRun, std::move(sequence)));
+    }
+}
+
+const SequenceTable &SequenceCache::getSequences(const Graph &graph, GraphInterface::Color color)
+{
+    std::pair<uint64_t, GraphInterface::Color> key(getGraphHash(graph), color);
+    auto found = _tables.find(key);
+    if (found != _tables.end())
+    {
+        return found->second;
+    }
+    SequenceTable table = graph.getSequences(color);
+    std::ofstream stream(_path, std::ios::app);
+    if (!stream)
+    {
+        throw std::runtime_error("Cannot open sequence cache " + _path.string());
+    }
+    stream << std::hex << key.first << std::dec << " " << GraphInterface::getColorName(color) << " "
+           << table.getMaxRun() << " " << table.getSequenceMax().size();
+    for (size_t id: table.getSequenceMax())
+    {
+        stream << " " << id;
+    }
+    stream << std::endl;
+    return _tables.emplace(key, std::move(table)).first->second;
+}
+
+size_t SequenceCache::size() const
+{
+    return _tables.size();
+}
@@ -0,0 +1,30 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_SEQUENCECACHE_H
+#define RED_BLUE_GRAPH_SOLVER_1_SEQUENCECACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include "Graph.h"
+#include "SequenceTable.h"
+
+// Results of Graph::getSequences kept in a text file across runs, one line per graph hash and color
+// ("<hash> <color name> <max run> <sequence size> <ids...>"), the hash being the one of the compact graph of its
+// number of colors. A graph already in the file is not searched again, a new result is appended to the file.
+class SequenceCache
+{
+public:
+    SequenceCache() = delete;
+    explicit SequenceCache(std::filesystem::path path);
+    SequenceCache(const SequenceCache &otherCache) = delete;
+    ~SequenceCache() = default;
+
+    [[nodiscard]] const SequenceTable &getSequences(const Graph &graph, GraphInterface::Color color);
+
+    [[nodiscard]] size_t size() const;
+
+private:
+    std::filesystem::path _path;
+    std::map<std::pair<uint64_t, GraphInterface::Color>, SequenceTable> _tables;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_SEQUENCECACHE_H
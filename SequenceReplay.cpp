@@ -0,0 +1,196 @@
+#include "SequenceReplay.h"
+#include "Graph.h"
+
+namespace
+{
+    constexpr size_t PREFETCH_DISTANCE = 4;
+}
+
+SequenceReplay::SequenceReplay(GraphInterface::Color color) : _color(color)
+{}
+
+template<size_t COLOR_COUNT>
+std::optional<GraphInterface::Color> SequenceReplay::initialColor(const BasicCompactGraph<COLOR_COUNT> &graph,
+                                                                  size_t id)
+{
+    if (!graph.nodeExists(graph.getInitialState(), id))
+    {
+        return std::nullopt;
+    }
+    return graph.getColor(graph.getInitialState(), id);
+}
+
+std::optional<GraphInterface::Color> SequenceReplay::initialColor(const FlatGraph &graph, size_t id)
+{
+    if (id >= graph._maxCapacity || !graph._nodes[id].has_value())
+    {
+        return std::nullopt;
+    }
+    return graph._nodes[id]->color;
+}
+
+template<typename GraphType>
+std::optional<GraphInterface::Color> SequenceReplay::currentColor(const GraphType &graph, size_t id) const
+{
+    if (id >= _overlay.size() || _overlay[id] == UNTOUCHED)
+    {
+        return initialColor(graph, id);
+    }
+    if (_overlay[id] == REMOVED)
+    {
+        return std::nullopt;
+    }
+    return static_cast<GraphInterface::Color>(_overlay[id] - PAINTED);
+}
+
+void SequenceReplay::paint(size_t id, GraphInterface::Color color)
+{
+    if (_overlay[id] == REMOVED)
+    {
+        return;
+    }
+    if (_overlay[id] == UNTOUCHED)
+    {
+        _touched.push_back(id);
+    }
+    _overlay[id] = static_cast<Overlay>(PAINTED + static_cast<uint8_t>(color));
+}
+
+template<size_t COLOR_COUNT>
+void SequenceReplay::paintNeighbors(const BasicCompactGraph<COLOR_COUNT> &graph, size_t id)
+{
+    for (const typename BasicCompactGraph<COLOR_COUNT>::Edge &edge: graph.getOutEdges(id))
+    {
+        if (graph.nodeExists(graph.getInitialState(), edge.node))
+        {
+            paint(edge.node, edge.color);
+        }
+    }
+}
+
+void SequenceReplay::paintNeighbors(const FlatGraph &graph, size_t id)
+{
+    // Edges only disappear with their nodes, and the removed nodes are never painted
+    if (id + 1 < graph._maxCapacity && graph._edges[id].has_value() && !graph._edges[id]->isLeft
+        && graph._nodes[id + 1].has_value())
+    {
+        paint(id + 1, graph._edges[id]->color);
+    }
+    if (id > 0 && graph._edges[id - 1].has_value() && graph._edges[id - 1]->isLeft && graph._nodes[id - 1].has_value())
+    {
+        paint(id - 1, graph._edges[id - 1]->color);
+    }
+}
+
+template<typename GraphType>
+SequenceReplay::Summary SequenceReplay::replaySteps(const GraphType &graph, const std::deque<size_t> &sequence)
+{
+    if (_overlay.size() < graph.getMaxCapacity())
+    {
+        _overlay.resize(graph.getMaxCapacity(), UNTOUCHED);
+    }
+    Summary summary;
+    size_t step = 0;
+    for (auto it = sequence.begin(); it != sequence.end(); ++it, ++step)
+    {
+        size_t id = *it;
+        std::optional<GraphInterface::Color> color = currentColor(graph, id);
+        if (!color.has_value())
+        {
+            summary.firstInvalidStep = step;
+            break;
+        }
+        summary.run = *color == _color ? summary.run + 1 : 0;
+        paintNeighbors(graph, id);
+        if (_overlay[id] == UNTOUCHED)
+        {
+            _touched.push_back(id);
+        }
+        _overlay[id] = REMOVED;
+    }
+    return summary;
+}
+
+template<typename GraphType>
+std::vector<std::optional<GraphInterface::Color>> SequenceReplay::collectColors(const GraphType &graph) const
+{
+    std::vector<std::optional<GraphInterface::Color>> colors(graph.getMaxCapacity());
+    for (size_t i = 0; i < colors.size(); ++i)
+    {
+        colors[i] = currentColor(graph, i);
+    }
+    return colors;
+}
+
+void SequenceReplay::clearOverlay()
+{
+    for (size_t id: _touched)
+    {
+        _overlay[id] = UNTOUCHED;
+    }
+    _touched.clear();
+}
+
+template<size_t COLOR_COUNT>
+SequenceReplay::Result SequenceReplay::replay(const BasicCompactGraph<COLOR_COUNT> &graph,
+                                              const std::deque<size_t> &sequence)
+{
+    Summary summary = replaySteps(graph, sequence);
+    Result result{summary.run, summary.firstInvalidStep, collectColors(graph)};
+    clearOverlay();
+    return result;
+}
+
+SequenceReplay::Result SequenceReplay::replay(const Graph &graph, const std::deque<size_t> &sequence)
+{
+    // The four color planes hold the three and four color graphs alike
+    if (graph.getColorCount() > 2)
+    {
+        return replay(BasicCompactGraph<4>(graph), sequence);
+    }
+    return replay(CompactGraph(graph), sequence);
+}
+
+SequenceReplay::Result SequenceReplay::replay(const FlatGraph &graph, const std::deque<size_t> &sequence)
+{
+    Summary summary = replaySteps(graph, sequence);
+    Result result{summary.run, summary.firstInvalidStep, collectColors(graph)};
+    clearOverlay();
+    return result;
+}
+
+std::vector<SequenceReplay::Summary> SequenceReplay::replayBatch(const std::vector<FlatGraph> &graphs,
+                                                                 const std::vector<std::deque<size_t>> &sequences)
+{
+    if (graphs.size() != sequences.size())
+    {
+        throw GraphInterface::GraphModificationException("There must be one sequence per graph.");
+    }
+    std::vector<Summary> summaries;
+    summaries.reserve(graphs.size());
+    for (size_t i = 0; i < graphs.size(); ++i)
+    {
+        // Each graph and sequence lives in its own allocations: fetching the next ones while the current one is
+        // replayed hides most of the memory latency
+        if (i + PREFETCH_DISTANCE < graphs.size())
+        {
+            const FlatGraph &nextGraph = graphs[i + PREFETCH_DISTANCE];
+            __builtin_prefetch(nextGraph._nodes.data());
+            __builtin_prefetch(nextGraph._edges.data());
+            if (!sequences[i + PREFETCH_DISTANCE].empty())
+            {
+                __builtin_prefetch(&sequences[i + PREFETCH_DISTANCE].front());
+            }
+        }
+        summaries.push_back(replaySteps(graphs[i], sequences[i]));
+        clearOverlay();
+    }
+    return summaries;
+}
+
+template SequenceReplay::Result SequenceReplay::replay<2>(const BasicCompactGraph<2> &graph,
+                                                          const std::deque<size_t> &sequence);
+template SequenceReplay::Result SequenceReplay::replay<3>(const BasicCompactGraph<3> &graph,
+                                                          const std::deque<size_t> &sequence);
+template SequenceReplay::Result SequenceReplay::replay<4>(const BasicCompactGraph<4> &graph,
+                                                          const std::deque<size_t> &sequence);
@@ -0,0 +1,88 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_SEQUENCEREPLAY_H
+#define RED_BLUE_GRAPH_SOLVER_1_SEQUENCEREPLAY_H
+
+#include <deque>
+#include <optional>
+#include <vector>
+#include "CompactGraph.h"
+#include "FlatGraph.h"
+
+class Graph;
+
+// Replays a removal sequence without modifying the graph: only the nodes removed or recolored by the sequence are
+// written, in an overlay kept between two replays, so a replay costs O(k + total degree of the removed nodes)
+// whatever the size of the graph. The run is the number of nodes of the color removed at the end of the sequence,
+// and the replay stops at the first step removing a node that is not present.
+class SequenceReplay
+{
+public:
+    struct Summary
+    {
+        size_t run = 0;
+        std::optional<size_t> firstInvalidStep;
+    };
+
+    struct Result
+    {
+        size_t run = 0;
+        std::optional<size_t> firstInvalidStep;
+        // Colors once the valid steps are done, std::nullopt for the nodes not present
+        std::vector<std::optional<GraphInterface::Color>> finalColors;
+    };
+
+    SequenceReplay() = delete;
+    explicit SequenceReplay(GraphInterface::Color color);
+    SequenceReplay(const SequenceReplay &otherReplay) = default;
+    SequenceReplay &operator=(const SequenceReplay &other) = default;
+    ~SequenceReplay() = default;
+
+    template<size_t COLOR_COUNT>
+    [[nodiscard]] Result replay(const BasicCompactGraph<COLOR_COUNT> &graph, const std::deque<size_t> &sequence);
+
+    [[nodiscard]] Result replay(const Graph &graph, const std::deque<size_t> &sequence);
+
+    [[nodiscard]] Result replay(const FlatGraph &graph, const std::deque<size_t> &sequence);
+
+    // The sequence i is replayed on the graph i, without the final colors
+    [[nodiscard]] std::vector<Summary> replayBatch(const std::vector<FlatGraph> &graphs,
+                                                   const std::vector<std::deque<size_t>> &sequences);
+
+private:
+    // A node painted with the color c is PAINTED + c
+    enum Overlay : uint8_t
+    {
+        UNTOUCHED,
+        REMOVED,
+        PAINTED
+    };
+
+    GraphInterface::Color _color;
+    std::vector<Overlay> _overlay;
+    std::vector<size_t> _touched;
+
+    template<size_t COLOR_COUNT>
+    [[nodiscard]] static std::optional<GraphInterface::Color> initialColor(const BasicCompactGraph<COLOR_COUNT> &graph,
+                                                                           size_t id);
+
+    [[nodiscard]] static std::optional<GraphInterface::Color> initialColor(const FlatGraph &graph, size_t id);
+
+    void paint(size_t id, GraphInterface::Color color);
+
+    template<size_t COLOR_COUNT>
+    void paintNeighbors(const BasicCompactGraph<COLOR_COUNT> &graph, size_t id);
+
+    void paintNeighbors(const FlatGraph &graph, size_t id);
+
+    template<typename GraphType>
+    [[nodiscard]] std::optional<GraphInterface::Color> currentColor(const GraphType &graph, size_t id) const;
+
+    template<typename GraphType>
+    [[nodiscard]] Summary replaySteps(const GraphType &graph, const std::deque<size_t> &sequence);
+
+    template<typename GraphType>
+    [[nodiscard]] std::vector<std::optional<GraphInterface::Color>> collectColors(const GraphType &graph) const;
+
+    void clearOverlay();
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_SEQUENCEREPLAY_H
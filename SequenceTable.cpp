@@ -0,0 +1,34 @@
+#include "SequenceTable.h"
+
+SequenceTable::SequenceTable(size_t maxRun, std::deque<size_t> sequenceMax) : _maxRun(maxRun),
+                                                                              _sequenceMax(std::move(sequenceMax))
+{
+    if (_maxRun > _sequenceMax.size())
+    {
+        throw GraphInterface::GraphModificationException("Run is longer than the sequence.");
+    }
+}
+
+size_t SequenceTable::getMaxRun() const
+{
+    return _maxRun;
+}
+
+const std::deque<size_t> &SequenceTable::getSequenceMax() const
+{
+    return _sequenceMax;
+}
+
+std::optional<std::deque<size_t>> SequenceTable::getSequence(size_t k) const
+{
+    if (k > _maxRun)
+    {
+        return std::nullopt;
+    }
+    if (k == 0)
+    {
+        return std::deque<size_t>();
+    }
+    size_t prefixSize = _sequenceMax.size() - _maxRun;
+    return std::deque<size_t>(_sequenceMax.begin(), _sequenceMax.begin() + prefixSize + k);
+}
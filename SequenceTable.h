@@ -0,0 +1,30 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_SEQUENCETABLE_H
+#define RED_BLUE_GRAPH_SOLVER_1_SEQUENCETABLE_H
+
+#include <deque>
+#include <optional>
+#include "GraphInterface.h"
+
+// Answers of Graph::getSequence for every k, kept as a single sequence of maximum run: its prefix followed by the
+// first k nodes of its run ends with exactly k nodes of the color, and no sequence ends with more than maxRun.
+class SequenceTable
+{
+public:
+    SequenceTable() = delete;
+    SequenceTable(size_t maxRun, std::deque<size_t> sequenceMax);
+    SequenceTable(const SequenceTable &otherTable) = default;
+    SequenceTable &operator=(const SequenceTable &other) = default;
+    ~SequenceTable() = default;
+
+    [[nodiscard]] size_t getMaxRun() const;
+
+    [[nodiscard]] const std::deque<size_t> &getSequenceMax() const;
+
+    [[nodiscard]] std::optional<std::deque<size_t>> getSequence(size_t k) const;
+
+private:
+    size_t _maxRun;
+    std::deque<size_t> _sequenceMax;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_SEQUENCETABLE_H
@@ -0,0 +1,392 @@
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ShardedSweep.h"
+#include "FlatGraph.h"
+#include "FlatGraphGenerator.h"
+
+namespace
+{
+    uint64_t mix(uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    uint64_t hashText(const std::string &text)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (char c: text)
+        {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    std::filesystem::path getGridPath(const std::filesystem::path &directory)
+    {
+        return directory / "grid";
+    }
+
+    template<typename T>
+    void writeLine(std::ostream &os, const char *name, const std::vector<T> &values)
+    {
+        os << name;
+        for (const T &value: values)
+        {
+            os << " " << value;
+        }
+        os << "\n";
+    }
+
+    template<typename T>
+    std::vector<T> readLine(std::istream &is, const std::string &name)
+    {
+        std::string line, word;
+        if (!std::getline(is, line))
+        {
+            throw std::runtime_error("Sweep grid ends before " + name);
+        }
+        std::istringstream words(line);
+        if (!(words >> word) || word != name)
+        {
+            throw std::runtime_error("Sweep grid has no " + name);
+        }
+        std::vector<T> values;
+        T value;
+        while (words >> value)
+        {
+            values.push_back(value);
+        }
+        return values;
+    }
+
+    // Probabilities with all their digits, so that reading the grid back gives the same text and the same hash
+    std::string writeGrid(const ShardedSweep::Grid &grid)
+    {
+        std::ostringstream os;
+        os << std::setprecision(17);
+        writeLine(os, "sizes", grid.sizes);
+        writeLine(os, "p", grid.redNodeProbabilities);
+        writeLine(os, "q", grid.redEdgeProbabilities);
+        writeLine(os, "trials", std::vector<size_t>{grid.trialCount});
+        writeLine(os, "seed", std::vector<uint64_t>{grid.seed});
+        writeLine(os, "shards", std::vector<size_t>{grid.shardCount});
+        return os.str();
+    }
+
+    ShardedSweep::Grid readGrid(const std::string &text)
+    {
+        std::istringstream is(text);
+        ShardedSweep::Grid grid;
+        grid.sizes = readLine<size_t>(is, "sizes");
+        grid.redNodeProbabilities = readLine<double>(is, "p");
+        grid.redEdgeProbabilities = readLine<double>(is, "q");
+        std::vector<size_t> trialCount = readLine<size_t>(is, "trials");
+        std::vector<uint64_t> seed = readLine<uint64_t>(is, "seed");
+        std::vector<size_t> shardCount = readLine<size_t>(is, "shards");
+        if (trialCount.size() != 1 || seed.size() != 1 || shardCount.size() != 1)
+        {
+            throw std::runtime_error("Invalid sweep grid");
+        }
+        grid.trialCount = trialCount[0];
+        grid.seed = seed[0];
+        grid.shardCount = shardCount[0];
+        return grid;
+    }
+
+    void checkGrid(const ShardedSweep::Grid &grid)
+    {
+        for (size_t size: grid.sizes)
+        {
+            if (size < 2)
+            {
+                throw std::runtime_error("Sweep graphs need two nodes at least");
+            }
+        }
+        if (grid.shardCount == 0)
+        {
+            throw std::runtime_error("Sweep needs one shard at least");
+        }
+    }
+
+    // Written next to the file then renamed, so that the file is always a complete one
+    void writeFile(const std::filesystem::path &path, const std::string &text)
+    {
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::trunc);
+            file << text;
+            if (!file.flush())
+            {
+                throw std::runtime_error("Cannot write " + temporaryPath.string());
+            }
+        }
+        std::filesystem::rename(temporaryPath, path);
+    }
+}
+
+void ShardedSweep::Moments::add(uint64_t sample)
+{
+    uint64_t square;
+    if (__builtin_mul_overflow(sample, sample, &square))
+    {
+        throw std::overflow_error("Sweep moments overflow");
+    }
+    merge(Moments{1, sample, square});
+}
+
+void ShardedSweep::Moments::merge(const Moments &other)
+{
+    // The sums are only assigned once they all fit, so the moments are left as they were when it throws
+    uint64_t newCount, newSum, newSquaredSum;
+    if (__builtin_add_overflow(count, other.count, &newCount) || __builtin_add_overflow(sum, other.sum, &newSum)
+        || __builtin_add_overflow(squaredSum, other.squaredSum, &newSquaredSum))
+    {
+        throw std::overflow_error("Sweep moments overflow");
+    }
+    count = newCount;
+    sum = newSum;
+    squaredSum = newSquaredSum;
+}
+
+double ShardedSweep::Moments::getMean() const
+{
+    return count == 0 ? 0 : static_cast<double>(static_cast<long double>(sum) / count);
+}
+
+double ShardedSweep::Moments::getVariance() const
+{
+    if (count < 2)
+    {
+        return 0;
+    }
+    long double sumValue = sum;
+    return static_cast<double>((squaredSum - sumValue * sumValue / count) / (count - 1));
+}
+
+ShardedSweep::ShardedSweep(Grid grid, std::filesystem::path directory) : _grid(std::move(grid)),
+                                                                         _directory(std::move(directory))
+{
+    checkGrid(_grid);
+    std::string text = writeGrid(_grid);
+    _gridHash = hashText(text);
+    std::filesystem::create_directories(_directory);
+    writeFile(getGridPath(_directory), text);
+}
+
+ShardedSweep::ShardedSweep(std::filesystem::path directory) : _directory(std::move(directory))
+{
+    std::ifstream file(getGridPath(_directory));
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open the sweep grid in " + _directory.string());
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    _grid = readGrid(text);
+    checkGrid(_grid);
+    _gridHash = hashText(text);
+}
+
+bool ShardedSweep::hasGrid(const std::filesystem::path &directory)
+{
+    return std::filesystem::exists(getGridPath(directory));
+}
+
+const ShardedSweep::Grid &ShardedSweep::getGrid() const
+{
+    return _grid;
+}
+
+size_t ShardedSweep::getCell(size_t s, size_t p, size_t q) const
+{
+    return (s * _grid.redNodeProbabilities.size() + p) * _grid.redEdgeProbabilities.size() + q;
+}
+
+size_t ShardedSweep::getCellCount() const
+{
+    return _grid.sizes.size() * _grid.redNodeProbabilities.size() * _grid.redEdgeProbabilities.size();
+}
+
+void ShardedSweep::runShard(size_t shard) const
+{
+    if (shard >= _grid.shardCount)
+    {
+        throw std::out_of_range("Shard is out of range");
+    }
+    size_t cellCount = getCellCount();
+    size_t pCount = _grid.redNodeProbabilities.size();
+    size_t qCount = _grid.redEdgeProbabilities.size();
+    size_t unitCount = cellCount * _grid.trialCount;
+    size_t begin = unitCount * shard / _grid.shardCount;
+    size_t end = unitCount * (shard + 1) / _grid.shardCount;
+
+    std::vector<Moments> moments(cellCount * ESTIMATOR_COUNT);
+    std::vector<std::optional<FlatGraph>> graphs(_grid.sizes.size());
+    for (size_t unit = begin; unit < end; ++unit)
+    {
+        size_t cell = unit % cellCount;
+        size_t trial = unit / cellCount;
+        size_t s = cell / (pCount * qCount);
+        std::optional<FlatGraph> &graph = graphs[s];
+        if (!graph.has_value())
+        {
+            graph.emplace(_grid.sizes[s]);
+        }
+        FlatGraphGenerator generator(mix(_grid.seed + mix(trial * cellCount + cell)));
+        generator.generate(*graph, _grid.redNodeProbabilities[cell / qCount % pCount],
+                           _grid.redEdgeProbabilities[cell % qCount], 0.5);
+        moments[cell * ESTIMATOR_COUNT].add(graph->getSequenceMax(GraphInterface::Color::RED).size());
+        moments[cell * ESTIMATOR_COUNT + 1].add(graph->getSequenceMaxBis(GraphInterface::Color::RED).size());
+    }
+
+    std::ostringstream os;
+    os << "shard " << shard << " " << _gridHash << "\n";
+    for (size_t i = 0; i < moments.size(); ++i)
+    {
+        if (moments[i].count > 0)
+        {
+            os << i / ESTIMATOR_COUNT << " " << i % ESTIMATOR_COUNT << " " << moments[i].count << " "
+               << moments[i].sum << " " << moments[i].squaredSum << "\n";
+        }
+    }
+    writeFile(getShardPath(shard), os.str());
+}
+
+std::vector<size_t> ShardedSweep::runLocal(const std::string &executable, size_t workerCount,
+                                           size_t attemptCount) const
+{
+    std::vector<size_t> pending;
+    std::vector<Moments> moments(getCellCount() * ESTIMATOR_COUNT);
+    for (size_t shard = 0; shard < _grid.shardCount; ++shard)
+    {
+        if (!readShard(shard, moments))
+        {
+            pending.push_back(shard);
+        }
+    }
+    for (size_t attempt = 0; attempt < attemptCount && !pending.empty(); ++attempt)
+    {
+        pending = runWorkers(executable, pending, attempt == 0 ? workerCount : 1);
+    }
+    return pending;
+}
+
+std::vector<ShardedSweep::Moments> ShardedSweep::merge() const
+{
+    std::vector<Moments> moments(getCellCount() * ESTIMATOR_COUNT);
+    for (size_t shard = 0; shard < _grid.shardCount; ++shard)
+    {
+        if (!readShard(shard, moments))
+        {
+            throw std::runtime_error("Shard " + std::to_string(shard) + " of the sweep has no result");
+        }
+    }
+    return moments;
+}
+
+std::filesystem::path ShardedSweep::getShardPath(size_t shard) const
+{
+    return _directory / ("shard-" + std::to_string(shard));
+}
+
+bool ShardedSweep::readShard(size_t shard, std::vector<Moments> &moments) const
+{
+    std::ifstream file(getShardPath(shard));
+    std::string word;
+    size_t index;
+    uint64_t gridHash;
+    if (!(file >> word >> index >> gridHash) || word != "shard" || index != shard || gridHash != _gridHash)
+    {
+        return false;
+    }
+    // Added once the whole file is read, a file that cannot be read leaving the moments as they were
+    std::vector<std::pair<size_t, Moments>> shardMoments;
+    size_t cell, estimator;
+    Moments cellMoments;
+    while (file >> cell >> estimator >> cellMoments.count >> cellMoments.sum >> cellMoments.squaredSum)
+    {
+        if (cell >= getCellCount() || estimator >= ESTIMATOR_COUNT)
+        {
+            return false;
+        }
+        shardMoments.emplace_back(cell * ESTIMATOR_COUNT + estimator, cellMoments);
+    }
+    if (!file.eof())
+    {
+        return false;
+    }
+    for (const std::pair<size_t, Moments> &entry: shardMoments)
+    {
+        moments[entry.first].merge(entry.second);
+    }
+    return true;
+}
+
+std::vector<size_t> ShardedSweep::runWorkers(const std::string &executable, const std::vector<size_t> &shards,
+                                             size_t workerCount) const
+{
+    std::vector<size_t> failed;
+    std::map<pid_t, size_t> running;
+    std::vector<Moments> moments(getCellCount() * ESTIMATOR_COUNT);
+    size_t next = 0;
+    while (next < shards.size() || !running.empty())
+    {
+        while (next < shards.size() && running.size() < std::max<size_t>(workerCount, 1))
+        {
+            std::string directory = _directory.string();
+            std::string shard = std::to_string(shards[next]);
+            pid_t pid = fork();
+            if (pid == 0)
+            {
+                execlp(executable.c_str(), executable.c_str(), "--sweep-worker", directory.c_str(), shard.c_str(),
+                       static_cast<char *>(nullptr));
+                _exit(127);
+            }
+            if (pid < 0)
+            {
+                failed.push_back(shards[next]);
+            } else
+            {
+                running.emplace(pid, shards[next]);
+            }
+            next++;
+        }
+        if (running.empty())
+        {
+            continue;
+        }
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error("Cannot wait for the sweep workers");
+        }
+        auto worker = running.find(pid);
+        if (worker == running.end())
+        {
+            continue;
+        }
+        // The shard is done once its file is there, even when its worker died afterwards, and failed otherwise
+        if (!readShard(worker->second, moments))
+        {
+            failed.push_back(worker->second);
+        }
+        running.erase(worker);
+    }
+    return failed;
+}
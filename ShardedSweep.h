@@ -0,0 +1,101 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_SHARDEDSWEEP_H
+#define RED_BLUE_GRAPH_SOLVER_1_SHARDEDSWEEP_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Sweep of the red sequences of random FlatGraphs over a grid of sizes x node probabilities p x edge probabilities q,
+// run by separate processes. The trial t of the cell c always draws its graph from a seed made of the seed of the grid,
+// c and t, so a shard is a fixed range of (trial, cell) pairs and the results do not depend on the shard count nor on
+// where the shards ran. The range goes trial by trial over all the cells, so the shards share the large graphs.
+//
+// Everything goes through a directory, which a later version can share between hosts: the grid is written there, and
+// each worker writes the count, sum and sum of squares of the integer samples of each cell of its shard to its own
+// file, written then renamed so that a file present is complete. Merging adds these integers, so it is exact. The
+// coordinator runs the shards without a file in local worker processes, then runs each failed shard again on its own.
+class ShardedSweep
+{
+public:
+    struct Grid
+    {
+        std::vector<size_t> sizes;
+        std::vector<double> redNodeProbabilities;
+        std::vector<double> redEdgeProbabilities;
+        size_t trialCount;
+        uint64_t seed;
+        size_t shardCount;
+    };
+
+    // Sums of the samples of one estimator of a cell. Adding or merging throws std::overflow_error rather than lose
+    // exactness, which takes more than 10^5 trials of graphs of 10^7 nodes, and then leaves the sums unchanged.
+    struct Moments
+    {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t squaredSum = 0;
+
+        void add(uint64_t sample);
+
+        void merge(const Moments &other);
+
+        [[nodiscard]] double getMean() const;
+
+        [[nodiscard]] double getVariance() const;
+    };
+
+    // Red sequence sizes of FlatGraph::getSequenceMax and FlatGraph::getSequenceMaxBis
+    static constexpr size_t ESTIMATOR_COUNT = 2;
+
+    ShardedSweep() = delete;
+
+    // Writes the grid to the directory, created if needed, for the workers
+    ShardedSweep(Grid grid, std::filesystem::path directory);
+
+    // Grid already written to the directory, for a worker or to resume a sweep
+    explicit ShardedSweep(std::filesystem::path directory);
+
+    ShardedSweep(const ShardedSweep &otherSweep) = default;
+
+    ~ShardedSweep() = default;
+
+    [[nodiscard]] static bool hasGrid(const std::filesystem::path &directory);
+
+    [[nodiscard]] const Grid &getGrid() const;
+
+    // Cell of the size s, the node probability p and the edge probability q, as indices in the grid
+    [[nodiscard]] size_t getCell(size_t s, size_t p, size_t q) const;
+
+    [[nodiscard]] size_t getCellCount() const;
+
+    // Runs the shard in this process and writes its file
+    void runShard(size_t shard) const;
+
+    // Runs the shards without a file of this grid with at most workerCount processes "executable --sweep-worker
+    // <directory> <shard>" at once. A shard whose worker fails or writes no file is then run again alone, up to
+    // attemptCount runs in all. Returns the shards still failing.
+    [[nodiscard]] std::vector<size_t> runLocal(const std::string &executable, size_t workerCount,
+                                               size_t attemptCount = 3) const;
+
+    // Moments of the estimator e of the cell c at c * ESTIMATOR_COUNT + e, merged from the files of all the shards.
+    // Throws std::runtime_error when a shard has no file of this grid.
+    [[nodiscard]] std::vector<Moments> merge() const;
+
+private:
+    Grid _grid;
+    std::filesystem::path _directory;
+    // Hash of the grid file, written in the shard files to tell them from the ones of another grid
+    uint64_t _gridHash;
+
+    [[nodiscard]] std::filesystem::path getShardPath(size_t shard) const;
+
+    // False when the shard has no file of this grid
+    [[nodiscard]] bool readShard(size_t shard, std::vector<Moments> &moments) const;
+
+    // Runs the shards with at most workerCount processes at once and returns the ones that failed
+    [[nodiscard]] std::vector<size_t> runWorkers(const std::string &executable, const std::vector<size_t> &shards,
+                                                 size_t workerCount) const;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_SHARDEDSWEEP_H
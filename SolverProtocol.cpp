@@ -0,0 +1,292 @@
+#include <cstring>
+#include <fstream>
+#include "SolverProtocol.h"
+#include "CompactGraph.h"
+
+namespace
+{
+    template<typename T>
+    void append(std::vector<uint8_t> &buffer, T value)
+    {
+        size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    class ByteReader
+    {
+    public:
+        ByteReader(const uint8_t *bytes, size_t size) : _bytes(bytes), _size(size)
+        {}
+
+        template<typename T>
+        T read()
+        {
+            require(sizeof(T));
+            T value;
+            std::memcpy(&value, _bytes + _offset, sizeof(T));
+            _offset += sizeof(T);
+            return value;
+        }
+
+        const uint8_t *readBytes(size_t count)
+        {
+            require(count);
+            const uint8_t *bytes = _bytes + _offset;
+            _offset += count;
+            return bytes;
+        }
+
+        [[nodiscard]] size_t remaining() const
+        {
+            return _size - _offset;
+        }
+
+    private:
+        const uint8_t *_bytes;
+        size_t _size;
+        size_t _offset = 0;
+
+        void require(size_t count) const
+        {
+            if (count > _size - _offset)
+            {
+                throw GraphInterface::GraphModificationException("Truncated frame.");
+            }
+        }
+    };
+
+    uint8_t colorByte(GraphInterface::Color color)
+    {
+        if (color != GraphInterface::Color::RED && color != GraphInterface::Color::BLUE)
+        {
+            throw GraphInterface::GraphModificationException("Invalid color.");
+        }
+        return color == GraphInterface::Color::RED ? 1 : 2;
+    }
+
+    GraphInterface::Color byteColor(uint8_t byte)
+    {
+        if (byte != 1 && byte != 2)
+        {
+            throw GraphInterface::GraphModificationException("Invalid color.");
+        }
+        return byte == 1 ? GraphInterface::Color::RED : GraphInterface::Color::BLUE;
+    }
+}
+
+std::vector<uint8_t> SolverProtocol::flatGraphBytes(const FlatGraph &graph)
+{
+    std::vector<uint8_t> bytes;
+    append<uint32_t>(bytes, static_cast<uint32_t>(graph._maxCapacity));
+    for (const std::optional<FlatGraph::FlatGraphNode> &node: graph._nodes)
+    {
+        bytes.push_back(node.has_value() ? colorByte(node->color) : 0);
+    }
+    for (const std::optional<FlatGraph::FlatGraphEdge> &edge: graph._edges)
+    {
+        bytes.push_back(edge.has_value() ? colorByte(edge->color) | (edge->isLeft ? 4 : 0) : 0);
+    }
+    return bytes;
+}
+
+std::vector<uint8_t> SolverProtocol::graphBytes(const Graph &graph)
+{
+    CompactGraph compactGraph(graph);
+    const CompactGraph::State &state = compactGraph.getInitialState();
+    std::vector<uint8_t> bytes;
+    append<uint32_t>(bytes, static_cast<uint32_t>(compactGraph.getMaxCapacity()));
+    size_t edgeCount = 0;
+    for (size_t i = 0; i < compactGraph.getMaxCapacity(); ++i)
+    {
+        bytes.push_back(compactGraph.nodeExists(state, i) ? colorByte(compactGraph.getColor(state, i)) : 0);
+        edgeCount += compactGraph.getOutEdges(i).size();
+    }
+    append<uint32_t>(bytes, static_cast<uint32_t>(edgeCount));
+    for (size_t i = 0; i < compactGraph.getMaxCapacity(); ++i)
+    {
+        for (const CompactGraph::Edge &edge: compactGraph.getOutEdges(i))
+        {
+            append<uint32_t>(bytes, static_cast<uint32_t>(i));
+            append<uint32_t>(bytes, edge.node);
+            bytes.push_back(colorByte(edge.color));
+        }
+    }
+    return bytes;
+}
+
+std::vector<uint8_t> SolverProtocol::requestFrame(uint64_t requestId, Kind kind, GraphInterface::Color color,
+                                                  const std::vector<uint8_t> &payload)
+{
+    std::vector<uint8_t> frame;
+    frame.reserve(sizeof(uint32_t) + sizeof(uint64_t) + 2 + payload.size());
+    append<uint32_t>(frame, static_cast<uint32_t>(sizeof(uint64_t) + 2 + payload.size()));
+    append<uint64_t>(frame, requestId);
+    frame.push_back(static_cast<uint8_t>(kind));
+    frame.push_back(colorByte(color) - 1);
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    return frame;
+}
+
+std::vector<uint8_t> SolverProtocol::encodeRequest(uint64_t requestId, const FlatGraph &graph,
+                                                   GraphInterface::Color color)
+{
+    return requestFrame(requestId, Kind::FLAT_GRAPH, color, flatGraphBytes(graph));
+}
+
+std::vector<uint8_t> SolverProtocol::encodeRequest(uint64_t requestId, const Graph &graph, GraphInterface::Color color)
+{
+    return requestFrame(requestId, Kind::GRAPH, color, graphBytes(graph));
+}
+
+std::vector<uint8_t> SolverProtocol::encodeFileRequest(uint64_t requestId, const std::filesystem::path &path,
+                                                       GraphInterface::Color color)
+{
+    std::string pathString = path.string();
+    return requestFrame(requestId, Kind::FILE, color, std::vector<uint8_t>(pathString.begin(), pathString.end()));
+}
+
+void SolverProtocol::writeFile(const std::filesystem::path &path, Kind kind, const std::vector<uint8_t> &bytes)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open the graph file " + path.string());
+    }
+    file.put(static_cast<char>(kind));
+    file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void SolverProtocol::writeGraphFile(const std::filesystem::path &path, const FlatGraph &graph)
+{
+    writeFile(path, Kind::FLAT_GRAPH, flatGraphBytes(graph));
+}
+
+void SolverProtocol::writeGraphFile(const std::filesystem::path &path, const Graph &graph)
+{
+    writeFile(path, Kind::GRAPH, graphBytes(graph));
+}
+
+SolverProtocol::Request SolverProtocol::decodeRequest(const uint8_t *frame, size_t size)
+{
+    ByteReader reader(frame, size);
+    Request request{};
+    request.requestId = reader.read<uint64_t>();
+    uint8_t kind = reader.read<uint8_t>();
+    uint8_t color = reader.read<uint8_t>();
+    if (kind > static_cast<uint8_t>(Kind::FILE) || color > 1)
+    {
+        throw GraphInterface::GraphModificationException("Invalid request header.");
+    }
+    request.kind = static_cast<Kind>(kind);
+    request.color = color == 0 ? GraphInterface::Color::RED : GraphInterface::Color::BLUE;
+    size_t payloadSize = reader.remaining();
+    const uint8_t *payload = reader.readBytes(payloadSize);
+    request.payload.assign(payload, payload + payloadSize);
+    return request;
+}
+
+FlatGraph SolverProtocol::decodeFlatGraph(const uint8_t *bytes, size_t size)
+{
+    ByteReader reader(bytes, size);
+    size_t nodeCount = reader.read<uint32_t>();
+    if (nodeCount == 0)
+    {
+        throw GraphInterface::GraphModificationException("Empty flat graph.");
+    }
+    const uint8_t *nodes = reader.readBytes(nodeCount);
+    const uint8_t *edges = reader.readBytes(nodeCount - 1);
+    FlatGraph graph(nodeCount);
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        if (nodes[i] != 0)
+        {
+            graph.createNode(byteColor(nodes[i]), i);
+        }
+    }
+    for (size_t i = 0; i + 1 < nodeCount; ++i)
+    {
+        if (edges[i] == 0)
+        {
+            continue;
+        }
+        GraphInterface::Color color = byteColor(edges[i] & 3);
+        if (edges[i] & 4)
+        {
+            graph.addEdge(i + 1, i, color);
+        } else
+        {
+            graph.addEdge(i, i + 1, color);
+        }
+    }
+    return graph;
+}
+
+Graph SolverProtocol::decodeGraph(const uint8_t *bytes, size_t size)
+{
+    ByteReader reader(bytes, size);
+    size_t nodeCount = reader.read<uint32_t>();
+    const uint8_t *nodes = reader.readBytes(nodeCount);
+    Graph graph(nodeCount);
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        if (nodes[i] != 0)
+        {
+            graph.createNode(byteColor(nodes[i]), i);
+        }
+    }
+    size_t edgeCount = reader.read<uint32_t>();
+    for (size_t e = 0; e < edgeCount; ++e)
+    {
+        size_t from = reader.read<uint32_t>();
+        size_t to = reader.read<uint32_t>();
+        GraphInterface::Color color = byteColor(reader.read<uint8_t>());
+        graph.addEdge(from, to, color);
+    }
+    return graph;
+}
+
+void SolverProtocol::encodeResponse(const Response &response, std::vector<uint8_t> &buffer)
+{
+    size_t lengthOffset = buffer.size();
+    append<uint32_t>(buffer, 0);
+    append<uint64_t>(buffer, response.requestId);
+    buffer.push_back(static_cast<uint8_t>(response.status));
+    if (response.status != Status::ERROR)
+    {
+        append<uint32_t>(buffer, static_cast<uint32_t>(response.run));
+        append<uint32_t>(buffer, static_cast<uint32_t>(response.sequence.size()));
+        for (size_t id: response.sequence)
+        {
+            append<uint32_t>(buffer, static_cast<uint32_t>(id));
+        }
+    } else
+    {
+        buffer.insert(buffer.end(), response.error.begin(), response.error.end());
+    }
+    uint32_t length = static_cast<uint32_t>(buffer.size() - lengthOffset - sizeof(uint32_t));
+    std::memcpy(buffer.data() + lengthOffset, &length, sizeof(length));
+}
+
+SolverProtocol::Response SolverProtocol::decodeResponse(const uint8_t *frame, size_t size)
+{
+    ByteReader reader(frame, size);
+    Response response{};
+    response.requestId = reader.read<uint64_t>();
+    response.status = static_cast<Status>(reader.read<uint8_t>());
+    if (response.status != Status::ERROR)
+    {
+        response.run = reader.read<uint32_t>();
+        size_t sequenceSize = reader.read<uint32_t>();
+        for (size_t i = 0; i < sequenceSize; ++i)
+        {
+            response.sequence.push_back(reader.read<uint32_t>());
+        }
+    } else
+    {
+        size_t errorSize = reader.remaining();
+        const uint8_t *error = reader.readBytes(errorSize);
+        response.error.assign(error, error + errorSize);
+    }
+    return response;
+}
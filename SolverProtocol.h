@@ -0,0 +1,104 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_SOLVERPROTOCOL_H
+#define RED_BLUE_GRAPH_SOLVER_1_SOLVERPROTOCOL_H
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "FlatGraph.h"
+#include "Graph.h"
+
+// Binary frames of SolverServer, integers in host byte order (the socket is local). Every frame starts with its
+// length (uint32, the length itself excluded) and the request id (uint64), which is copied in the response since
+// the responses of a connection come back in completion order.
+//
+// Request: kind (uint8), color (uint8, 0 for RED and 1 for BLUE), then the graph:
+//   FLAT_GRAPH: node count n (uint32), n node bytes, n - 1 edge bytes
+//   GRAPH:      node count n (uint32), n node bytes, edge count m (uint32), m edges (from uint32, to uint32, color uint8)
+//   FILE:       path of a file holding a kind byte (FLAT_GRAPH or GRAPH) followed by the graph, mapped in memory
+// A node byte is 0 for no node, 1 for RED and 2 for BLUE. An edge byte of a flat graph is 0 for no edge, else 1 for
+// RED or 2 for BLUE, plus 4 when the edge goes from the node i + 1 to the node i.
+//
+// Response: status (uint8), then for OK and BUDGET_EXCEEDED the run (uint32), the sequence size s (uint32) and s node
+// ids (uint32), and for ERROR the message. BUDGET_EXCEEDED is the best sequence found by a search stopped by the memory
+// budget of the server.
+class SolverProtocol
+{
+public:
+    enum class Kind : uint8_t
+    {
+        FLAT_GRAPH,
+        GRAPH,
+        FILE
+    };
+
+    enum class Status : uint8_t
+    {
+        OK,
+        ERROR,
+        BUDGET_EXCEEDED
+    };
+
+    struct Request
+    {
+        uint64_t requestId;
+        Kind kind;
+        GraphInterface::Color color;
+        // Graph bytes (starting at the node count) for FLAT_GRAPH and GRAPH, path for FILE
+        std::vector<uint8_t> payload;
+    };
+
+    struct Response
+    {
+        uint64_t requestId;
+        Status status;
+        size_t run;
+        std::deque<size_t> sequence;
+        std::string error;
+    };
+
+    static constexpr size_t MAX_FRAME_SIZE = size_t(1) << 30;
+
+    SolverProtocol() = delete;
+
+    [[nodiscard]] static std::vector<uint8_t> encodeRequest(uint64_t requestId, const FlatGraph &graph,
+                                                            GraphInterface::Color color);
+
+    [[nodiscard]] static std::vector<uint8_t> encodeRequest(uint64_t requestId, const Graph &graph,
+                                                            GraphInterface::Color color);
+
+    [[nodiscard]] static std::vector<uint8_t> encodeFileRequest(uint64_t requestId, const std::filesystem::path &path,
+                                                                GraphInterface::Color color);
+
+    // Graph file referenced by a FILE request
+    static void writeGraphFile(const std::filesystem::path &path, const FlatGraph &graph);
+
+    static void writeGraphFile(const std::filesystem::path &path, const Graph &graph);
+
+    // Frame without its length
+    [[nodiscard]] static Request decodeRequest(const uint8_t *frame, size_t size);
+
+    // Graph bytes of a FLAT_GRAPH or GRAPH request
+    [[nodiscard]] static FlatGraph decodeFlatGraph(const uint8_t *bytes, size_t size);
+
+    [[nodiscard]] static Graph decodeGraph(const uint8_t *bytes, size_t size);
+
+    // Appends the frame of the response, length included
+    static void encodeResponse(const Response &response, std::vector<uint8_t> &buffer);
+
+    // Frame without its length
+    [[nodiscard]] static Response decodeResponse(const uint8_t *frame, size_t size);
+
+private:
+    [[nodiscard]] static std::vector<uint8_t> flatGraphBytes(const FlatGraph &graph);
+
+    [[nodiscard]] static std::vector<uint8_t> graphBytes(const Graph &graph);
+
+    [[nodiscard]] static std::vector<uint8_t> requestFrame(uint64_t requestId, Kind kind, GraphInterface::Color color,
+                                                           const std::vector<uint8_t> &payload);
+
+    static void writeFile(const std::filesystem::path &path, Kind kind, const std::vector<uint8_t> &bytes);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_SOLVERPROTOCOL_H
@@ -0,0 +1,408 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "SolverServer.h"
+#include "CompactGraph.h"
+#include "GraphSolver.h"
+
+namespace
+{
+    constexpr size_t READ_CHUNK_SIZE = 1 << 16;
+
+    void sendAll(int socket, const std::vector<uint8_t> &buffer)
+    {
+        size_t sent = 0;
+        while (sent < buffer.size())
+        {
+            ssize_t written = send(socket, buffer.data() + sent, buffer.size() - sent, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                return;
+            }
+            sent += written;
+        }
+    }
+
+    // Read-only mapping of a graph file, unmapped when it goes out of scope
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string &path)
+        {
+            int file = open(path.c_str(), O_RDONLY);
+            if (file < 0)
+            {
+                throw std::runtime_error("Cannot open the graph file " + path);
+            }
+            struct stat status{};
+            if (fstat(file, &status) != 0 || status.st_size == 0)
+            {
+                close(file);
+                throw std::runtime_error("Cannot read the graph file " + path);
+            }
+            _size = status.st_size;
+            void *data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+            close(file);
+            if (data == MAP_FAILED)
+            {
+                throw std::runtime_error("Cannot map the graph file " + path);
+            }
+            _data = static_cast<const uint8_t *>(data);
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        ~MappedFile()
+        {
+            munmap(const_cast<uint8_t *>(_data), _size);
+        }
+
+        [[nodiscard]] const uint8_t *data() const
+        {
+            return _data;
+        }
+
+        [[nodiscard]] size_t size() const
+        {
+            return _size;
+        }
+
+    private:
+        const uint8_t *_data = nullptr;
+        size_t _size = 0;
+    };
+}
+
+SolverServer::Connection::Connection(int socket) : socket(socket)
+{}
+
+SolverServer::Connection::~Connection()
+{
+    close(socket);
+}
+
+SolverServer::SolverServer(std::filesystem::path socketPath, size_t workerCount, size_t cacheCapacity,
+                           size_t memoryBudget)
+        : _socketPath(std::move(socketPath)), _workerCount(std::max<size_t>(workerCount, 1)),
+          _cacheCapacity(cacheCapacity), _memoryBudget(memoryBudget)
+{}
+
+SolverServer::~SolverServer()
+{
+    stop();
+}
+
+size_t SolverServer::getAnsweredCount() const
+{
+    return _answeredCount;
+}
+
+void SolverServer::stop()
+{
+    _stopping = true;
+    int listenSocket = _listenSocket;
+    if (listenSocket >= 0)
+    {
+        shutdown(listenSocket, SHUT_RDWR);
+    }
+}
+
+void SolverServer::run()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::string path = _socketPath.string();
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("Socket path is too long: " + path);
+    }
+    std::strcpy(address.sun_path, path.c_str());
+    int listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenSocket < 0)
+    {
+        throw std::runtime_error("Cannot create the socket " + path);
+    }
+    unlink(path.c_str());
+    if (bind(listenSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0
+        || listen(listenSocket, SOMAXCONN) != 0)
+    {
+        close(listenSocket);
+        throw std::runtime_error("Cannot listen on the socket " + path);
+    }
+    _listenSocket = listenSocket;
+    if (_stopping)
+    {
+        shutdown(listenSocket, SHUT_RDWR);
+    }
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < _workerCount; ++i)
+    {
+        workers.emplace_back(&SolverServer::work, this);
+    }
+    while (!_stopping)
+    {
+        int connectionSocket = accept(listenSocket, nullptr, nullptr);
+        if (connectionSocket < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+            break;
+        }
+        joinFinishedReaders();
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(connectionSocket);
+        std::lock_guard<std::mutex> lock(_readersMutex);
+        _connections.erase(std::remove_if(_connections.begin(), _connections.end(),
+                                          [](const std::weak_ptr<Connection> &c) { return c.expired(); }),
+                           _connections.end());
+        _connections.push_back(connection);
+        _readers.emplace_back(&SolverServer::readConnection, this, connection);
+    }
+
+    // The readers stop on the shut down connections, then the workers answer what is left in the queue
+    {
+        std::lock_guard<std::mutex> lock(_readersMutex);
+        for (const std::weak_ptr<Connection> &weakConnection: _connections)
+        {
+            if (std::shared_ptr<Connection> connection = weakConnection.lock())
+            {
+                shutdown(connection->socket, SHUT_RD);
+            }
+        }
+    }
+    for (std::thread &reader: _readers)
+    {
+        reader.join();
+    }
+    _readers.clear();
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _workersStopping = true;
+    }
+    _queueCondition.notify_all();
+    for (std::thread &worker: workers)
+    {
+        worker.join();
+    }
+    _listenSocket = -1;
+    close(listenSocket);
+    unlink(path.c_str());
+}
+
+void SolverServer::joinFinishedReaders()
+{
+    std::lock_guard<std::mutex> lock(_readersMutex);
+    for (std::thread::id id: _finishedReaders)
+    {
+        auto reader = std::find_if(_readers.begin(), _readers.end(),
+                                   [id](const std::thread &thread) { return thread.get_id() == id; });
+        if (reader != _readers.end())
+        {
+            reader->join();
+            _readers.erase(reader);
+        }
+    }
+    _finishedReaders.clear();
+}
+
+void SolverServer::readConnection(std::shared_ptr<Connection> connection)
+{
+    std::vector<uint8_t> buffer;
+    size_t consumed = 0;
+    std::vector<Job> jobs;
+    bool reading = true;
+    while (reading)
+    {
+        size_t size = buffer.size();
+        buffer.resize(size + READ_CHUNK_SIZE);
+        ssize_t received = recv(connection->socket, buffer.data() + size, READ_CHUNK_SIZE, 0);
+        if (received < 0 && errno == EINTR)
+        {
+            buffer.resize(size);
+            continue;
+        }
+        buffer.resize(size + std::max<ssize_t>(received, 0));
+        reading = received > 0;
+
+        while (buffer.size() - consumed >= sizeof(uint32_t))
+        {
+            uint32_t length;
+            std::memcpy(&length, buffer.data() + consumed, sizeof(length));
+            if (length > SolverProtocol::MAX_FRAME_SIZE || length < sizeof(uint64_t))
+            {
+                reading = false;
+                break;
+            }
+            if (buffer.size() - consumed - sizeof(uint32_t) < length)
+            {
+                break;
+            }
+            const uint8_t *frame = buffer.data() + consumed + sizeof(uint32_t);
+            consumed += sizeof(uint32_t) + length;
+            try
+            {
+                jobs.push_back(Job{connection, SolverProtocol::decodeRequest(frame, length)});
+            }
+            catch (const std::exception &e)
+            {
+                SolverProtocol::Response response{};
+                std::memcpy(&response.requestId, frame, sizeof(response.requestId));
+                response.status = SolverProtocol::Status::ERROR;
+                response.error = e.what();
+                std::vector<uint8_t> responseBuffer;
+                SolverProtocol::encodeResponse(response, responseBuffer);
+                std::lock_guard<std::mutex> lock(connection->writeMutex);
+                sendAll(connection->socket, responseBuffer);
+            }
+        }
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(consumed));
+        consumed = 0;
+
+        if (!jobs.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                std::move(jobs.begin(), jobs.end(), std::back_inserter(_queue));
+            }
+            if (jobs.size() == 1)
+            {
+                _queueCondition.notify_one();
+            } else
+            {
+                _queueCondition.notify_all();
+            }
+            jobs.clear();
+        }
+    }
+    std::lock_guard<std::mutex> lock(_readersMutex);
+    _finishedReaders.push_back(std::this_thread::get_id());
+}
+
+void SolverServer::work()
+{
+    std::vector<Job> batch;
+    // Response buffers kept from one batch to the other, one per connection of the batch
+    std::vector<std::pair<std::shared_ptr<Connection>, std::vector<uint8_t>>> outputs;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            _queueCondition.wait(lock, [this]() { return !_queue.empty() || _workersStopping; });
+            if (_queue.empty())
+            {
+                return;
+            }
+            // Small batches when the queue is short, so that every worker gets some of it
+            size_t batchSize = std::min(BATCH_SIZE, std::max<size_t>(1, _queue.size() / _workerCount));
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                batch.push_back(std::move(_queue.front()));
+                _queue.pop_front();
+            }
+        }
+
+        size_t outputCount = 0;
+        for (const Job &job: batch)
+        {
+            auto output = std::find_if(outputs.begin(), outputs.begin() + static_cast<std::ptrdiff_t>(outputCount),
+                                       [&job](const auto &o) { return o.first == job.connection; });
+            if (output == outputs.begin() + static_cast<std::ptrdiff_t>(outputCount))
+            {
+                if (outputCount == outputs.size())
+                {
+                    outputs.emplace_back();
+                }
+                output = outputs.begin() + static_cast<std::ptrdiff_t>(outputCount++);
+                output->first = job.connection;
+                output->second.clear();
+            }
+            SolverProtocol::encodeResponse(solve(job.request), output->second);
+        }
+        for (size_t i = 0; i < outputCount; ++i)
+        {
+            {
+                std::lock_guard<std::mutex> lock(outputs[i].first->writeMutex);
+                sendAll(outputs[i].first->socket, outputs[i].second);
+            }
+            outputs[i].first.reset();
+        }
+        _answeredCount += batch.size();
+        batch.clear();
+    }
+}
+
+SolverProtocol::Response SolverServer::solve(const SolverProtocol::Request &request)
+{
+    try
+    {
+        if (request.kind != SolverProtocol::Kind::FILE)
+        {
+            return solveGraph(request.requestId, request.kind, request.color, request.payload.data(),
+                              request.payload.size());
+        }
+        MappedFile file(std::string(request.payload.begin(), request.payload.end()));
+        auto kind = static_cast<SolverProtocol::Kind>(file.data()[0]);
+        if (kind != SolverProtocol::Kind::FLAT_GRAPH && kind != SolverProtocol::Kind::GRAPH)
+        {
+            throw GraphInterface::GraphModificationException("Invalid graph file kind.");
+        }
+        return solveGraph(request.requestId, kind, request.color, file.data() + 1, file.size() - 1);
+    }
+    catch (const std::exception &e)
+    {
+        return SolverProtocol::Response{request.requestId, SolverProtocol::Status::ERROR, 0, {}, e.what()};
+    }
+}
+
+SolverProtocol::Response SolverServer::solveGraph(uint64_t requestId, SolverProtocol::Kind kind,
+                                                  GraphInterface::Color color, const uint8_t *bytes, size_t size)
+{
+    if (kind == SolverProtocol::Kind::FLAT_GRAPH)
+    {
+        FlatGraph flatGraph = SolverProtocol::decodeFlatGraph(bytes, size);
+        std::deque<size_t> sequence = flatGraph.getSequenceMax(color);
+        size_t run = sequence.size();
+        return SolverProtocol::Response{requestId, SolverProtocol::Status::OK, run, std::move(sequence), {}};
+    }
+    Graph graph = SolverProtocol::decodeGraph(bytes, size);
+    std::pair<uint64_t, GraphInterface::Color> key(CompactGraph(graph).getGraphHash(), color);
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto cached = _cache.find(key);
+        if (cached != _cache.end())
+        {
+            SolverProtocol::Response response = cached->second;
+            response.requestId = requestId;
+            return response;
+        }
+    }
+    GraphSolver::SolveResult result = GraphSolver::solveMax(graph, color, _memoryBudget);
+    if (result.status == GraphSolver::Status::BUDGET_EXCEEDED)
+    {
+        // Not cached, a later request may find the memory to do better
+        return SolverProtocol::Response{requestId, SolverProtocol::Status::BUDGET_EXCEEDED, result.run,
+                                        std::move(result.sequence), {}};
+    }
+    SolverProtocol::Response response{requestId, SolverProtocol::Status::OK, result.run, std::move(result.sequence),
+                                      {}};
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    if (_cache.size() >= _cacheCapacity)
+    {
+        _cache.clear();
+    }
+    _cache.emplace(key, response);
+    return response;
+}
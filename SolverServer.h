@@ -0,0 +1,91 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_SOLVERSERVER_H
+#define RED_BLUE_GRAPH_SOLVER_1_SOLVERSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "MemoryBudget.h"
+#include "SolverProtocol.h"
+
+// Daemon answering SolverProtocol requests on a Unix domain socket. Each connection has a thread reading its
+// requests into a queue shared by the workers; a worker takes the queued requests by batches, solves them
+// (FlatGraph::getSequenceMax for flat graphs, GraphSolver::solveMax for the others) and writes the responses of a
+// batch going to the same connection with a single send. The results of the general graphs are kept in memory by
+// graph hash, so a graph sent again is answered without a search. The search of a general graph gets its own memory
+// budget, a pathological graph being answered with BUDGET_EXCEEDED instead of taking the workers down.
+class SolverServer
+{
+public:
+    SolverServer() = delete;
+    SolverServer(std::filesystem::path socketPath, size_t workerCount, size_t cacheCapacity = 1 << 16,
+                 size_t memoryBudget = MemoryBudget::UNLIMITED);
+    SolverServer(const SolverServer &otherServer) = delete;
+    SolverServer &operator=(const SolverServer &other) = delete;
+    ~SolverServer();
+
+    // Listens until stop is called
+    void run();
+
+    void stop();
+
+    [[nodiscard]] size_t getAnsweredCount() const;
+
+private:
+    struct Connection
+    {
+        int socket;
+        std::mutex writeMutex;
+
+        explicit Connection(int socket);
+        ~Connection();
+    };
+
+    struct Job
+    {
+        std::shared_ptr<Connection> connection;
+        SolverProtocol::Request request;
+    };
+
+    static constexpr size_t BATCH_SIZE = 64;
+
+    std::filesystem::path _socketPath;
+    size_t _workerCount;
+    size_t _cacheCapacity;
+    size_t _memoryBudget;
+    std::atomic<int> _listenSocket{-1};
+    std::atomic<bool> _stopping{false};
+    std::atomic<size_t> _answeredCount{0};
+
+    std::mutex _queueMutex;
+    std::condition_variable _queueCondition;
+    std::deque<Job> _queue;
+
+    std::mutex _cacheMutex;
+    std::map<std::pair<uint64_t, GraphInterface::Color>, SolverProtocol::Response> _cache;
+
+    // Finished readers are joined on the next connection, the others when the server stops
+    std::mutex _readersMutex;
+    std::vector<std::thread> _readers;
+    std::vector<std::thread::id> _finishedReaders;
+    std::vector<std::weak_ptr<Connection>> _connections;
+    bool _workersStopping = false;
+
+    void joinFinishedReaders();
+
+    void readConnection(std::shared_ptr<Connection> connection);
+
+    void work();
+
+    [[nodiscard]] SolverProtocol::Response solve(const SolverProtocol::Request &request);
+
+    [[nodiscard]] SolverProtocol::Response solveGraph(uint64_t requestId, SolverProtocol::Kind kind,
+                                                      GraphInterface::Color color, const uint8_t *bytes, size_t size);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_SOLVERSERVER_H
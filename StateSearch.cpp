@@ -0,0 +1,889 @@
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include "StateSearch.h"
+
+namespace
+{
+    constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+    constexpr char CHECKPOINT_MAGIC[4] = {'R', 'B', 'S', 'S'};
+    constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+    // The words of the planes follow the word of the nodes present, as in the hash of CompactGraph
+    template<size_t COLOR_COUNT>
+    uint64_t hashState(const typename BasicCompactGraph<COLOR_COUNT>::State &state)
+    {
+        const size_t wordCount = state.present.size();
+        uint64_t h = 0x9E3779B97F4A7C15ull;
+        for (size_t i = 0; i < wordCount; ++i)
+        {
+            for (size_t p = 0; p <= BasicCompactGraph<COLOR_COUNT>::PLANE_COUNT; ++p)
+            {
+                uint64_t word = p == 0 ? state.present[i] : state.planes[(p - 1) * wordCount + i];
+                h ^= word + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+                h ^= h >> 31;
+                h *= 0xBF58476D1CE4E5B9ull;
+            }
+        }
+        return h ^ (h >> 29);
+    }
+
+    // Set of the indices of a layer, two indices being equal when their states have the same bitsets
+    template<size_t COLOR_COUNT>
+    struct LayerIndexHash
+    {
+        const std::vector<typename BasicCompactGraph<COLOR_COUNT>::State> &layer;
+
+        size_t operator()(uint32_t index) const
+        {
+            return hashState<COLOR_COUNT>(layer[index]);
+        }
+    };
+
+    template<size_t COLOR_COUNT>
+    struct LayerIndexEqual
+    {
+        const std::vector<typename BasicCompactGraph<COLOR_COUNT>::State> &layer;
+
+        bool operator()(uint32_t index1, uint32_t index2) const
+        {
+            return layer[index1].present == layer[index2].present && layer[index1].planes == layer[index2].planes;
+        }
+    };
+
+    template<size_t COLOR_COUNT>
+    using LayerIndexSet = std::unordered_set<uint32_t, LayerIndexHash<COLOR_COUNT>, LayerIndexEqual<COLOR_COUNT>>;
+
+    // Runs function(0) to function(threadCount - 1), each on its own thread
+    template<typename Function>
+    void runParallel(size_t threadCount, const Function &function)
+    {
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < threadCount; ++t)
+        {
+            threads.emplace_back(function, t);
+        }
+        function(0);
+        for (std::thread &thread: threads)
+        {
+            thread.join();
+        }
+    }
+
+    std::vector<uint8_t> getColorCodes(const std::vector<GraphInterface::Color> &colors)
+    {
+        std::vector<uint8_t> codes;
+        for (GraphInterface::Color color: colors)
+        {
+            codes.push_back(static_cast<uint8_t>(color));
+        }
+        return codes;
+    }
+
+    template<typename T>
+    void writeValue(std::ofstream &file, const T &value)
+    {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void writeArray(std::ofstream &file, const std::vector<T> &values)
+    {
+        writeValue<uint64_t>(file, values.size());
+        file.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    template<typename T>
+    T readValue(std::ifstream &file)
+    {
+        T value{};
+        if (!file.read(reinterpret_cast<char *>(&value), sizeof(T)))
+        {
+            throw std::runtime_error("Truncated checkpoint file.");
+        }
+        return value;
+    }
+
+    template<typename T>
+    std::vector<T> readArray(std::ifstream &file)
+    {
+        std::vector<T> values(readValue<uint64_t>(file));
+        if (!file.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T))))
+        {
+            throw std::runtime_error("Truncated checkpoint file.");
+        }
+        return values;
+    }
+}
+
+// Writes the snapshots handed by the search on its own thread. The search and the writer each own one snapshot and
+// swap them when the writer is idle, so the search never waits for the disk.
+template<size_t COLOR_COUNT>
+class BasicStateSearch<COLOR_COUNT>::CheckpointWriter
+{
+public:
+    struct Snapshot
+    {
+        uint64_t graphHash = 0;
+        uint64_t wordCount = 0;
+        std::vector<uint8_t> colors;
+        uint64_t depth = 0;
+        uint64_t visitedStateCount = 0;
+        std::vector<uint64_t> bestRuns;
+        std::vector<uint64_t> bestDepths;
+        std::vector<uint64_t> bestIndices;
+        std::vector<uint64_t> lowerBoundRuns;
+        std::vector<std::vector<uint64_t>> lowerBoundSequences;
+        // Layers of parents already done, which the search does not modify any more
+        std::vector<const std::vector<Parent> *> parents;
+        // Last layer, handed over by the search once expanded and freed by the writer once written
+        Layer layer;
+    };
+
+    explicit CheckpointWriter(std::filesystem::path path) : _path(std::move(path)),
+                                                            _thread(&CheckpointWriter::run, this)
+    {}
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    ~CheckpointWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+    }
+
+    // Whether the snapshot offered last is still being written
+    bool isBusy()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_error.empty())
+        {
+            throw std::runtime_error(_error);
+        }
+        return _busy;
+    }
+
+    // Gives the snapshot to the writer, which must not be busy, and the previous buffer back
+    void offer(Snapshot &snapshot)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::swap(snapshot, _pending);
+        _busy = true;
+        _condition.notify_all();
+    }
+
+    // Waits for the snapshot being written, whose parents must stay valid until then
+    void finish()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this]() { return !_busy; });
+        if (!_error.empty())
+        {
+            throw std::runtime_error(_error);
+        }
+    }
+
+private:
+    std::filesystem::path _path;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    Snapshot _pending;
+    bool _busy = false;
+    bool _stopping = false;
+    std::string _error;
+    std::thread _thread;
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _condition.wait(lock, [this]() { return _busy || _stopping; });
+            if (!_busy)
+            {
+                return;
+            }
+            lock.unlock();
+            bool written = write(_pending);
+            _pending.layer = Layer();
+            lock.lock();
+            if (!written)
+            {
+                _error = "Cannot write the checkpoint file " + _path.string();
+            }
+            _busy = false;
+            _condition.notify_all();
+        }
+    }
+
+    // Written next to the checkpoint then renamed, so that the checkpoint is always a complete one
+    bool write(const Snapshot &snapshot) const
+    {
+        std::filesystem::path temporaryPath = _path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+            writeValue(file, CHECKPOINT_VERSION);
+            writeValue(file, snapshot.graphHash);
+            writeValue(file, snapshot.wordCount);
+            writeArray(file, snapshot.colors);
+            writeValue(file, snapshot.depth);
+            writeValue(file, snapshot.visitedStateCount);
+            writeArray(file, snapshot.bestRuns);
+            writeArray(file, snapshot.bestDepths);
+            writeArray(file, snapshot.bestIndices);
+            writeArray(file, snapshot.lowerBoundRuns);
+            for (const std::vector<uint64_t> &sequence: snapshot.lowerBoundSequences)
+            {
+                writeArray(file, sequence);
+            }
+            writeValue<uint64_t>(file, snapshot.parents.size());
+            for (const std::vector<Parent> *parents: snapshot.parents)
+            {
+                writeArray(file, *parents);
+            }
+            // The words of the states, present then planes, as one array
+            writeValue<uint64_t>(file, snapshot.layer.states.size() * (1 + BasicCompactGraph<COLOR_COUNT>::PLANE_COUNT)
+                                       * snapshot.wordCount);
+            for (const State &state: snapshot.layer.states)
+            {
+                file.write(reinterpret_cast<const char *>(state.present.data()),
+                           static_cast<std::streamsize>(state.present.size() * sizeof(uint64_t)));
+                file.write(reinterpret_cast<const char *>(state.planes.data()),
+                           static_cast<std::streamsize>(state.planes.size() * sizeof(uint64_t)));
+            }
+            writeArray(file, snapshot.layer.runs);
+            writeArray(file, snapshot.layer.alive);
+            file.flush();
+            if (!file)
+            {
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, _path, error);
+        return !error;
+    }
+};
+
+template<size_t COLOR_COUNT>
+BasicStateSearch<COLOR_COUNT>::BasicStateSearch(const BasicCompactGraph<COLOR_COUNT> &graph,
+                                                GraphInterface::Color color) : _graph(graph), _color(color)
+{}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::setThreadCount(size_t threadCount)
+{
+    _threadCount = std::max<size_t>(threadCount, 1);
+}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::setCheckpoint(std::filesystem::path path, std::chrono::milliseconds interval)
+{
+    _checkpointPath = std::move(path);
+    _checkpointInterval = interval;
+}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::setMemoryBudget(MemoryBudget *budget)
+{
+    _budget = budget;
+}
+
+template<size_t COLOR_COUNT>
+size_t BasicStateSearch<COLOR_COUNT>::getVisitedStateCount() const
+{
+    return _visitedStateCount;
+}
+
+template<size_t COLOR_COUNT>
+size_t BasicStateSearch<COLOR_COUNT>::getCheckpointCount() const
+{
+    return _checkpointCount;
+}
+
+template<size_t COLOR_COUNT>
+bool BasicStateSearch<COLOR_COUNT>::hasResumed() const
+{
+    return _resumed;
+}
+
+template<size_t COLOR_COUNT>
+size_t BasicStateSearch<COLOR_COUNT>::getStateBytes(size_t colorCount) const
+{
+    return sizeof(State) + (1 + BasicCompactGraph<COLOR_COUNT>::PLANE_COUNT) * _graph.getWordCount() * sizeof(uint64_t)
+           + colorCount * sizeof(uint32_t) + sizeof(uint8_t);
+}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::charge(size_t bytes) const
+{
+    if (_budget != nullptr)
+    {
+        _budget->charge(bytes);
+    }
+}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::release(size_t bytes) const
+{
+    if (_budget != nullptr)
+    {
+        _budget->release(bytes);
+    }
+}
+
+template<size_t COLOR_COUNT>
+bool BasicStateSearch<COLOR_COUNT>::mayImprove(const State &state, const std::vector<GraphInterface::Color> &colors,
+                                               const uint32_t *runs, const std::vector<size_t> &bestRuns,
+                                               uint8_t &alive) const
+{
+    std::array<size_t, COLOR_COUNT> bounds{};
+    for (size_t c = 0; c < colors.size(); ++c)
+    {
+        bounds[c] = runs[c];
+    }
+    for (size_t i = 0; i < _graph.getMaxCapacity(); ++i)
+    {
+        if (!_graph.nodeExists(state, i))
+        {
+            continue;
+        }
+        GraphInterface::Color nodeColor = _graph.getColor(state, i);
+        std::array<bool, COLOR_COUNT> counted{};
+        size_t missing = 0;
+        for (size_t c = 0; c < colors.size(); ++c)
+        {
+            counted[c] = !(alive & (1u << c)) || colors[c] == nodeColor;
+            if (!(alive & (1u << c)))
+            {
+                continue;
+            }
+            if (counted[c])
+            {
+                bounds[c]++;
+            } else
+            {
+                missing++;
+            }
+        }
+        for (const typename BasicCompactGraph<COLOR_COUNT>::Edge &edge: _graph.getInEdges(i))
+        {
+            if (missing == 0)
+            {
+                break;
+            }
+            if (!_graph.nodeExists(state, edge.node))
+            {
+                continue;
+            }
+            for (size_t c = 0; c < colors.size(); ++c)
+            {
+                if (!counted[c] && colors[c] == edge.color)
+                {
+                    counted[c] = true;
+                    bounds[c]++;
+                    missing--;
+                }
+            }
+        }
+    }
+    for (size_t c = 0; c < colors.size(); ++c)
+    {
+        if (bounds[c] <= bestRuns[c])
+        {
+            alive &= ~(1u << c);
+        }
+    }
+    return alive != 0;
+}
+
+template<size_t COLOR_COUNT>
+std::pair<size_t, std::deque<size_t>>
+BasicStateSearch<COLOR_COUNT>::solveMax(std::pair<size_t, std::deque<size_t>> lowerBound)
+{
+    std::vector<std::pair<size_t, std::deque<size_t>>> lowerBounds;
+    lowerBounds.push_back(std::move(lowerBound));
+    return std::move(solve({_color}, std::move(lowerBounds)).front());
+}
+
+template<size_t COLOR_COUNT>
+std::pair<std::pair<size_t, std::deque<size_t>>, std::pair<size_t, std::deque<size_t>>>
+BasicStateSearch<COLOR_COUNT>::solveMaxBothColors(std::pair<size_t, std::deque<size_t>> redLowerBound,
+                                                  std::pair<size_t, std::deque<size_t>> blueLowerBound)
+{
+    std::vector<std::pair<size_t, std::deque<size_t>>> lowerBounds;
+    lowerBounds.push_back(std::move(redLowerBound));
+    lowerBounds.push_back(std::move(blueLowerBound));
+    std::vector<std::pair<size_t, std::deque<size_t>>> results = solve(
+            {GraphInterface::Color::RED, GraphInterface::Color::BLUE}, std::move(lowerBounds));
+    return std::make_pair(std::move(results[0]), std::move(results[1]));
+}
+
+template<size_t COLOR_COUNT>
+std::vector<std::pair<size_t, std::deque<size_t>>>
+BasicStateSearch<COLOR_COUNT>::solve(const std::vector<GraphInterface::Color> &colors,
+                                     std::vector<std::pair<size_t, std::deque<size_t>>> lowerBounds)
+{
+    const size_t colorCount = colors.size();
+    Progress progress;
+    _resumed = _checkpointPath.has_value() && loadCheckpoint(colors, progress);
+    const size_t stateBytes = getStateBytes(colorCount);
+    if (_resumed)
+    {
+        // The layer saved is counted again when the search goes through it
+        _visitedStateCount = progress.visitedStateCount;
+        charge(progress.layer.states.size() * stateBytes);
+        for (const std::vector<Parent> &parents: progress.parents)
+        {
+            charge(parents.size() * sizeof(Parent));
+        }
+        // A lower bound given now may beat the best run saved
+        for (size_t c = 0; c < colorCount; ++c)
+        {
+            if (lowerBounds[c].first > progress.bestRuns[c])
+            {
+                progress.bestRuns[c] = lowerBounds[c].first;
+                progress.bestDepths[c] = NOT_FOUND;
+                progress.lowerBounds[c] = std::move(lowerBounds[c]);
+            }
+        }
+    } else
+    {
+        progress.bestDepths.assign(colorCount, NOT_FOUND);
+        progress.bestIndices.assign(colorCount, 0);
+        for (size_t c = 0; c < colorCount; ++c)
+        {
+            progress.bestRuns.push_back(lowerBounds[c].first);
+        }
+        progress.lowerBounds = std::move(lowerBounds);
+
+        State initialState(_graph.getInitialState());
+        initialState.run = 0;
+        initialState.sequence.clear();
+        progress.layer.runs.assign(colorCount, 0);
+        progress.layer.alive.assign(1, static_cast<uint8_t>((1u << colorCount) - 1));
+        if (mayImprove(initialState, colors, progress.layer.runs.data(), progress.bestRuns,
+                       progress.layer.alive.front()))
+        {
+            progress.layer.states.push_back(std::move(initialState));
+            progress.parents.emplace_back(colorCount, Parent{0, 0});
+            charge(stateBytes + colorCount * sizeof(Parent));
+        }
+    }
+
+    std::optional<CheckpointWriter> writer;
+    typename CheckpointWriter::Snapshot snapshot;
+    if (_checkpointPath.has_value())
+    {
+        writer.emplace(*_checkpointPath);
+    }
+    std::chrono::steady_clock::time_point lastCheckpoint = std::chrono::steady_clock::now();
+    // Bytes of the layer held by the writer, charged until it is written
+    size_t writtenLayerBytes = 0;
+    bool isComplete = true;
+    for (; !progress.layer.states.empty(); ++progress.depth)
+    {
+        Layer &layer = progress.layer;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (writtenLayerBytes > 0 && !writer->isBusy())
+        {
+            release(writtenLayerBytes);
+            writtenLayerBytes = 0;
+        }
+        // A layer expanded once the budget was exceeded may miss states, so it is never saved: the checkpoint stays
+        // the last complete layer, from which a search without budget resumes exactly
+        bool isTruncated = _budget != nullptr && _budget->isExceeded();
+        bool isCheckpointDue = writer.has_value() && !isTruncated && writtenLayerBytes == 0
+                               && now - lastCheckpoint >= _checkpointInterval;
+        if (isCheckpointDue)
+        {
+            // The parents of the previous layers are written where they are, the layer is handed over once expanded
+            snapshot.graphHash = _graph.getGraphHash();
+            snapshot.wordCount = _graph.getWordCount();
+            snapshot.colors = getColorCodes(colors);
+            snapshot.depth = progress.depth;
+            snapshot.visitedStateCount = _visitedStateCount;
+            snapshot.bestRuns.assign(progress.bestRuns.begin(), progress.bestRuns.end());
+            snapshot.bestDepths.assign(progress.bestDepths.begin(), progress.bestDepths.end());
+            snapshot.bestIndices.assign(progress.bestIndices.begin(), progress.bestIndices.end());
+            snapshot.lowerBoundRuns.clear();
+            snapshot.lowerBoundSequences.resize(colorCount);
+            for (size_t c = 0; c < colorCount; ++c)
+            {
+                snapshot.lowerBoundRuns.push_back(progress.lowerBounds[c].first);
+                snapshot.lowerBoundSequences[c].assign(progress.lowerBounds[c].second.begin(),
+                                                       progress.lowerBounds[c].second.end());
+            }
+            snapshot.parents.clear();
+            for (const std::vector<Parent> &parents: progress.parents)
+            {
+                snapshot.parents.push_back(&parents);
+            }
+        }
+
+        _visitedStateCount += layer.states.size();
+        for (size_t i = 0; i < layer.states.size(); ++i)
+        {
+            for (size_t c = 0; c < colorCount; ++c)
+            {
+                if (layer.runs[i * colorCount + c] > progress.bestRuns[c])
+                {
+                    progress.bestRuns[c] = layer.runs[i * colorCount + c];
+                    progress.bestDepths[c] = progress.depth;
+                    progress.bestIndices[c] = i;
+                }
+            }
+        }
+        // The runs of the layer cut short by the budget are valid, the search stops once they are counted
+        isComplete = _budget == nullptr || !_budget->isExceeded();
+        Layer nextLayer;
+        if (isComplete)
+        {
+            nextLayer = expandLayer(layer, colors, progress.bestRuns);
+        }
+        size_t layerBytes = layer.states.size() * stateBytes;
+        if (isCheckpointDue)
+        {
+            snapshot.layer = std::move(layer);
+            writer->offer(snapshot);
+            _checkpointCount++;
+            lastCheckpoint = now;
+            writtenLayerBytes = layerBytes;
+        } else
+        {
+            release(layerBytes);
+        }
+        if (!isComplete)
+        {
+            break;
+        }
+        progress.parents.push_back(std::move(nextLayer.parents));
+        progress.layer = std::move(nextLayer);
+    }
+    for (const std::vector<Parent> &parents: progress.parents)
+    {
+        release(parents.size() * sizeof(Parent));
+    }
+    if (writer.has_value())
+    {
+        writer->finish();
+        writer.reset();
+        release(writtenLayerBytes);
+        if (isComplete)
+        {
+            std::filesystem::remove(*_checkpointPath);
+        }
+    }
+
+    std::vector<std::pair<size_t, std::deque<size_t>>> results;
+    for (size_t c = 0; c < colorCount; ++c)
+    {
+        if (progress.bestDepths[c] == NOT_FOUND)
+        {
+            results.push_back(std::move(progress.lowerBounds[c]));
+            continue;
+        }
+        std::deque<size_t> sequence;
+        for (size_t depth = progress.bestDepths[c], index = progress.bestIndices[c]; depth > 0; --depth)
+        {
+            sequence.push_front(progress.parents[depth][index * colorCount + c].removedNode);
+            index = progress.parents[depth][index * colorCount + c].index;
+        }
+        results.emplace_back(progress.bestRuns[c], std::move(sequence));
+    }
+    return results;
+}
+
+template<size_t COLOR_COUNT>
+template<typename IndexSet>
+bool BasicStateSearch<COLOR_COUNT>::addChild(const Layer &layer, size_t parent, size_t node,
+                                             GraphInterface::Color removedColor,
+                                             const std::vector<GraphInterface::Color> &colors, State &child,
+                                             IndexSet &seen, Layer &nextLayer) const
+{
+    const size_t colorCount = colors.size();
+    nextLayer.states.push_back(std::move(child));
+    auto inserted = seen.insert(static_cast<uint32_t>(nextLayer.states.size() - 1));
+    if (inserted.second)
+    {
+        if (_budget != nullptr && !_budget->tryCharge(getStateBytes(colorCount) + colorCount * sizeof(Parent)))
+        {
+            seen.erase(inserted.first);
+            nextLayer.states.pop_back();
+            return false;
+        }
+        nextLayer.alive.push_back(layer.alive[parent]);
+        for (size_t c = 0; c < colorCount; ++c)
+        {
+            nextLayer.runs.push_back(removedColor == colors[c] ? layer.runs[parent * colorCount + c] + 1 : 0);
+            nextLayer.parents.push_back(Parent{static_cast<uint32_t>(parent), static_cast<uint32_t>(node)});
+        }
+        return true;
+    }
+    size_t existing = *inserted.first;
+    nextLayer.alive[existing] |= layer.alive[parent];
+    for (size_t c = 0; c < colorCount; ++c)
+    {
+        uint32_t run = removedColor == colors[c] ? layer.runs[parent * colorCount + c] + 1 : 0;
+        if (run > nextLayer.runs[existing * colorCount + c])
+        {
+            nextLayer.runs[existing * colorCount + c] = run;
+            nextLayer.parents[existing * colorCount + c] = Parent{static_cast<uint32_t>(parent),
+                                                                  static_cast<uint32_t>(node)};
+        }
+    }
+    child = std::move(nextLayer.states.back());
+    nextLayer.states.pop_back();
+    return true;
+}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::expandStates(const Layer &layer, const std::vector<GraphInterface::Color> &colors,
+                                                 Layer &nextLayer) const
+{
+    LayerIndexSet<COLOR_COUNT> seen(16, LayerIndexHash<COLOR_COUNT>{nextLayer.states},
+                                    LayerIndexEqual<COLOR_COUNT>{nextLayer.states});
+    // The duplicates give their bitsets back to the next child
+    State child;
+    for (size_t i = 0; i < layer.states.size(); ++i)
+    {
+        if (_budget != nullptr && _budget->isExceeded())
+        {
+            return;
+        }
+        for (size_t node = 0; node < _graph.getMaxCapacity(); ++node)
+        {
+            if (!_graph.nodeExists(layer.states[i], node))
+            {
+                continue;
+            }
+            child.present = layer.states[i].present;
+            child.planes = layer.states[i].planes;
+            GraphInterface::Color removedColor = _graph.getColor(child, node);
+            _graph.removeNode(child, node);
+            if (!addChild(layer, i, node, removedColor, colors, child, seen, nextLayer))
+            {
+                return;
+            }
+        }
+    }
+}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::routeChildren(const Layer &layer, size_t begin, size_t end,
+                                                  std::vector<std::vector<ChildReference>> &buckets) const
+{
+    State child;
+    for (size_t i = begin; i < end; ++i)
+    {
+        for (size_t node = 0; node < _graph.getMaxCapacity(); ++node)
+        {
+            if (!_graph.nodeExists(layer.states[i], node))
+            {
+                continue;
+            }
+            child.present = layer.states[i].present;
+            child.planes = layer.states[i].planes;
+            _graph.removeNode(child, node);
+            buckets[hashState<COLOR_COUNT>(child) % buckets.size()].push_back(
+                    ChildReference{static_cast<uint32_t>(i), static_cast<uint32_t>(node)});
+        }
+    }
+}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::expandBucket(const Layer &layer,
+                                                 const std::vector<std::vector<std::vector<ChildReference>>> &routes,
+                                                 size_t bucket, const std::vector<GraphInterface::Color> &colors,
+                                                 Layer &nextLayer) const
+{
+    LayerIndexSet<COLOR_COUNT> seen(16, LayerIndexHash<COLOR_COUNT>{nextLayer.states},
+                                    LayerIndexEqual<COLOR_COUNT>{nextLayer.states});
+    State child;
+    for (const std::vector<std::vector<ChildReference>> &threadRoutes: routes)
+    {
+        for (const ChildReference &reference: threadRoutes[bucket])
+        {
+            if (_budget != nullptr && _budget->isExceeded())
+            {
+                return;
+            }
+            const State &parent = layer.states[reference.parent];
+            child.present = parent.present;
+            child.planes = parent.planes;
+            GraphInterface::Color removedColor = _graph.getColor(child, reference.node);
+            _graph.removeNode(child, reference.node);
+            if (!addChild(layer, reference.parent, reference.node, removedColor, colors, child, seen, nextLayer))
+            {
+                return;
+            }
+        }
+    }
+}
+
+template<size_t COLOR_COUNT>
+void BasicStateSearch<COLOR_COUNT>::pruneLayer(Layer &layer, const std::vector<GraphInterface::Color> &colors,
+                                               const std::vector<size_t> &bestRuns) const
+{
+    const size_t colorCount = colors.size();
+    size_t kept = 0;
+    for (size_t j = 0; j < layer.states.size(); ++j)
+    {
+        if (!mayImprove(layer.states[j], colors, &layer.runs[j * colorCount], bestRuns, layer.alive[j]))
+        {
+            continue;
+        }
+        if (kept != j)
+        {
+            layer.states[kept] = std::move(layer.states[j]);
+            layer.alive[kept] = layer.alive[j];
+            for (size_t c = 0; c < colorCount; ++c)
+            {
+                layer.runs[kept * colorCount + c] = layer.runs[j * colorCount + c];
+                layer.parents[kept * colorCount + c] = layer.parents[j * colorCount + c];
+            }
+        }
+        kept++;
+    }
+    release((layer.states.size() - kept) * (getStateBytes(colorCount) + colorCount * sizeof(Parent)));
+    layer.states.resize(kept);
+    layer.runs.resize(kept * colorCount);
+    layer.alive.resize(kept);
+    layer.parents.resize(kept * colorCount);
+}
+
+template<size_t COLOR_COUNT>
+typename BasicStateSearch<COLOR_COUNT>::Layer
+BasicStateSearch<COLOR_COUNT>::expandLayer(const Layer &layer, const std::vector<GraphInterface::Color> &colors,
+                                           const std::vector<size_t> &bestRuns) const
+{
+    const size_t threadCount = _threadCount;
+    Layer nextLayer;
+    if (threadCount == 1)
+    {
+        expandStates(layer, colors, nextLayer);
+        pruneLayer(nextLayer, colors, bestRuns);
+        return nextLayer;
+    }
+
+    // Each thread sends the children of its share of the layer to the bucket of their hash, as a parent and a node,
+    // then builds and keeps once the children of its own bucket: the buckets never share a state and a child is
+    // only stored by the thread that keeps it
+    std::vector<std::vector<std::vector<ChildReference>>> routes(threadCount,
+                                                                 std::vector<std::vector<ChildReference>>(threadCount));
+    runParallel(threadCount, [&](size_t t)
+    {
+        routeChildren(layer, layer.states.size() * t / threadCount, layer.states.size() * (t + 1) / threadCount,
+                      routes[t]);
+    });
+    size_t routeBytes = 0;
+    for (const std::vector<std::vector<ChildReference>> &threadRoutes: routes)
+    {
+        for (const std::vector<ChildReference> &bucketRoutes: threadRoutes)
+        {
+            routeBytes += bucketRoutes.capacity() * sizeof(ChildReference);
+        }
+    }
+    charge(routeBytes);
+    std::vector<Layer> buckets(threadCount);
+    runParallel(threadCount, [&](size_t b)
+    {
+        expandBucket(layer, routes, b, colors, buckets[b]);
+        pruneLayer(buckets[b], colors, bestRuns);
+    });
+    release(routeBytes);
+    nextLayer = std::move(buckets[0]);
+    for (size_t b = 1; b < threadCount; ++b)
+    {
+        std::move(buckets[b].states.begin(), buckets[b].states.end(), std::back_inserter(nextLayer.states));
+        nextLayer.runs.insert(nextLayer.runs.end(), buckets[b].runs.begin(), buckets[b].runs.end());
+        nextLayer.alive.insert(nextLayer.alive.end(), buckets[b].alive.begin(), buckets[b].alive.end());
+        nextLayer.parents.insert(nextLayer.parents.end(), buckets[b].parents.begin(), buckets[b].parents.end());
+    }
+    return nextLayer;
+}
+
+template<size_t COLOR_COUNT>
+bool BasicStateSearch<COLOR_COUNT>::loadCheckpoint(const std::vector<GraphInterface::Color> &colors,
+                                                   Progress &progress) const
+{
+    std::ifstream file(*_checkpointPath, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), CHECKPOINT_MAGIC)
+        || readValue<uint32_t>(file) != CHECKPOINT_VERSION)
+    {
+        throw std::runtime_error("Invalid checkpoint file " + _checkpointPath->string());
+    }
+    const size_t colorCount = colors.size();
+    if (readValue<uint64_t>(file) != _graph.getGraphHash() || readValue<uint64_t>(file) != _graph.getWordCount()
+        || readArray<uint8_t>(file) != getColorCodes(colors))
+    {
+        throw std::runtime_error("Checkpoint file " + _checkpointPath->string() + " is of another search");
+    }
+    progress.depth = readValue<uint64_t>(file);
+    progress.visitedStateCount = readValue<uint64_t>(file);
+    std::vector<uint64_t> bestRuns = readArray<uint64_t>(file);
+    std::vector<uint64_t> bestDepths = readArray<uint64_t>(file);
+    std::vector<uint64_t> bestIndices = readArray<uint64_t>(file);
+    std::vector<uint64_t> lowerBoundRuns = readArray<uint64_t>(file);
+    if (bestRuns.size() != colorCount || bestDepths.size() != colorCount || bestIndices.size() != colorCount
+        || lowerBoundRuns.size() != colorCount)
+    {
+        throw std::runtime_error("Invalid checkpoint file " + _checkpointPath->string());
+    }
+    progress.bestRuns.assign(bestRuns.begin(), bestRuns.end());
+    progress.bestDepths.assign(bestDepths.begin(), bestDepths.end());
+    progress.bestIndices.assign(bestIndices.begin(), bestIndices.end());
+    for (size_t c = 0; c < colorCount; ++c)
+    {
+        std::vector<uint64_t> sequence = readArray<uint64_t>(file);
+        progress.lowerBounds.emplace_back(lowerBoundRuns[c], std::deque<size_t>(sequence.begin(), sequence.end()));
+    }
+    size_t parentLayerCount = readValue<uint64_t>(file);
+    for (size_t d = 0; d < parentLayerCount; ++d)
+    {
+        progress.parents.push_back(readArray<Parent>(file));
+    }
+    std::vector<uint64_t> words = readArray<uint64_t>(file);
+    progress.layer.runs = readArray<uint32_t>(file);
+    progress.layer.alive = readArray<uint8_t>(file);
+    const size_t wordCount = _graph.getWordCount();
+    const size_t stateCount = progress.layer.alive.size();
+    const size_t stateWordCount = (1 + BasicCompactGraph<COLOR_COUNT>::PLANE_COUNT) * wordCount;
+    if (parentLayerCount != progress.depth + 1 || words.size() != stateCount * stateWordCount
+        || progress.layer.runs.size() != stateCount * colorCount)
+    {
+        throw std::runtime_error("Invalid checkpoint file " + _checkpointPath->string());
+    }
+    for (size_t i = 0; i < stateCount; ++i)
+    {
+        State state;
+        auto stateWords = words.begin() + i * stateWordCount;
+        state.present.assign(stateWords, stateWords + wordCount);
+        state.planes.assign(stateWords + wordCount, stateWords + stateWordCount);
+        progress.layer.states.push_back(std::move(state));
+    }
+    return true;
+}
+
+template class BasicStateSearch<2>;
+template class BasicStateSearch<3>;
+template class BasicStateSearch<4>;
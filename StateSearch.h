@@ -0,0 +1,161 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_STATESEARCH_H
+#define RED_BLUE_GRAPH_SOLVER_1_STATESEARCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <optional>
+#include <vector>
+#include "CompactGraph.h"
+#include "MemoryBudget.h"
+
+// Exact search for the longest run, one layer per number of removed nodes. A state reached by several sequences is
+// kept once, with the longest run it can be reached with, and a state is dropped as soon as its run plus the nodes
+// that are or can still become of the color cannot beat the best run found. Searching both colors at once shares the
+// layers: a state keeps one run and one parent per color, and is dropped once neither of its runs can improve.
+//
+// A layer can be expanded by several threads: each one sends the children of a share of the states to the bucket of
+// their hash, then keeps each state of one bucket once. Two layers never share a state, so the search is entirely
+// described by the parents of the layers, the last layer and the best runs: with a checkpoint file, they are written
+// by a background thread at the end of a layer (the last layer is handed over to it once expanded, without a copy)
+// and a later search of the same graph, with any thread count, resumes from the file.
+//
+// The search is compiled for the number of colors of its graph, whose states hold that many bit planes.
+template<size_t COLOR_COUNT>
+class BasicStateSearch
+{
+public:
+    BasicStateSearch() = delete;
+    BasicStateSearch(const BasicCompactGraph<COLOR_COUNT> &graph, GraphInterface::Color color);
+    BasicStateSearch(const BasicStateSearch &otherSearch) = delete;
+    ~BasicStateSearch() = default;
+
+    void setThreadCount(size_t threadCount);
+
+    // The search is saved at most once per interval and the file is removed once the search is over
+    void setCheckpoint(std::filesystem::path path, std::chrono::milliseconds interval);
+
+    // The states of the layers and the parents are charged to the budget. Once it is exceeded, the layer being
+    // expanded is cut short, the best runs found so far are returned and the checkpoint file is kept, with the last
+    // complete layer only, so that a search resumed from it is exact.
+    void setMemoryBudget(MemoryBudget *budget);
+
+    // The lower bound is a valid sequence (a heuristic one for instance) returned when nothing better exists
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> solveMax(std::pair<size_t, std::deque<size_t>> lowerBound = {});
+
+    // Red then blue results whatever the color of the search, each lower bound being used for its own color
+    [[nodiscard]] std::pair<std::pair<size_t, std::deque<size_t>>, std::pair<size_t, std::deque<size_t>>>
+    solveMaxBothColors(std::pair<size_t, std::deque<size_t>> redLowerBound = {},
+                       std::pair<size_t, std::deque<size_t>> blueLowerBound = {});
+
+    [[nodiscard]] size_t getVisitedStateCount() const;
+
+    [[nodiscard]] size_t getCheckpointCount() const;
+
+    [[nodiscard]] bool hasResumed() const;
+
+private:
+    using State = typename BasicCompactGraph<COLOR_COUNT>::State;
+
+    struct Parent
+    {
+        uint32_t index;
+        uint32_t removedNode;
+    };
+
+    // Child of a state of the layer being expanded, built again by the thread of its bucket
+    struct ChildReference
+    {
+        uint32_t parent;
+        uint32_t node;
+    };
+
+    // Runs and parents of the state i for the color c are at i * colorCount + c. Bit c of alive is set while the
+    // color c may still improve from the state, the bound only decreasing along a sequence.
+    struct Layer
+    {
+        std::vector<State> states;
+        std::vector<uint32_t> runs;
+        std::vector<uint8_t> alive;
+        std::vector<Parent> parents;
+    };
+
+    struct Progress
+    {
+        size_t depth = 0;
+        size_t visitedStateCount = 0;
+        std::vector<size_t> bestRuns;
+        std::vector<size_t> bestDepths;
+        std::vector<size_t> bestIndices;
+        std::vector<std::pair<size_t, std::deque<size_t>>> lowerBounds;
+        // A deque so that the layers already written stay in place while a checkpoint reads them
+        std::deque<std::vector<Parent>> parents;
+        Layer layer;
+    };
+
+    class CheckpointWriter;
+
+    const BasicCompactGraph<COLOR_COUNT> &_graph;
+    GraphInterface::Color _color;
+    size_t _threadCount = 1;
+    std::optional<std::filesystem::path> _checkpointPath;
+    std::chrono::milliseconds _checkpointInterval{0};
+    MemoryBudget *_budget = nullptr;
+    size_t _visitedStateCount = 0;
+    size_t _checkpointCount = 0;
+    bool _resumed = false;
+
+    // Bytes of a state in a layer, its parents apart
+    [[nodiscard]] size_t getStateBytes(size_t colorCount) const;
+
+    void charge(size_t bytes) const;
+
+    void release(size_t bytes) const;
+
+    // Whether, for one of the alive colors, the run plus the nodes that are or can still become of the color beats the
+    // best run. The colors that cannot are cleared from alive.
+    [[nodiscard]] bool mayImprove(const State &state, const std::vector<GraphInterface::Color> &colors,
+                                  const uint32_t *runs, const std::vector<size_t> &bestRuns, uint8_t &alive) const;
+
+    // One result per color, in the same order
+    [[nodiscard]] std::vector<std::pair<size_t, std::deque<size_t>>>
+    solve(const std::vector<GraphInterface::Color> &colors,
+          std::vector<std::pair<size_t, std::deque<size_t>>> lowerBounds);
+
+    // Adds the child of the parent to the next layer, whose states are in seen, or keeps the longest runs and the
+    // alive colors of both when it is already there, the child then giving its bitsets back. False when the budget
+    // refuses a new state.
+    template<typename IndexSet>
+    bool addChild(const Layer &layer, size_t parent, size_t node, GraphInterface::Color removedColor,
+                  const std::vector<GraphInterface::Color> &colors, State &child, IndexSet &seen,
+                  Layer &nextLayer) const;
+
+    // Children of the states of the layer, each state kept once
+    void expandStates(const Layer &layer, const std::vector<GraphInterface::Color> &colors, Layer &nextLayer) const;
+
+    // Sends the children of the states begin to end of the layer to the bucket of their hash
+    void routeChildren(const Layer &layer, size_t begin, size_t end,
+                       std::vector<std::vector<ChildReference>> &buckets) const;
+
+    // Children sent to the bucket by every thread, each state kept once
+    void expandBucket(const Layer &layer, const std::vector<std::vector<std::vector<ChildReference>>> &routes,
+                      size_t bucket, const std::vector<GraphInterface::Color> &colors, Layer &nextLayer) const;
+
+    // Drops the states that cannot improve any more
+    void pruneLayer(Layer &layer, const std::vector<GraphInterface::Color> &colors,
+                    const std::vector<size_t> &bestRuns) const;
+
+    [[nodiscard]] Layer expandLayer(const Layer &layer, const std::vector<GraphInterface::Color> &colors,
+                                    const std::vector<size_t> &bestRuns) const;
+
+    [[nodiscard]] bool loadCheckpoint(const std::vector<GraphInterface::Color> &colors, Progress &progress) const;
+};
+
+extern template class BasicStateSearch<2>;
+extern template class BasicStateSearch<3>;
+extern template class BasicStateSearch<4>;
+
+using StateSearch = BasicStateSearch<2>;
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_STATESEARCH_H
@@ -0,0 +1,65 @@
+#include "StreamingFlatGraphSolver.h"
+
+StreamingFlatGraphSolver::StreamingFlatGraphSolver(GraphInterface::Color color) : _color(color)
+{}
+
+size_t StreamingFlatGraphSolver::solve(FlatGraphStream &stream, const Sink &sink) const
+{
+    FlatGraphStream::Element current, next;
+    if (!stream.next(current))
+    {
+        return 0;
+    }
+    bool hasNext = stream.next(next);
+    size_t currentId = 0;
+    // Nodes left of the current one linked to it by edges of the color going left, each one taking the color when
+    // the node at its right is removed
+    size_t leftChain = 0;
+    size_t run = 0;
+    while (true)
+    {
+        if (current.color == _color)
+        {
+            size_t rightChain = 0;
+            while (hasNext && next.color == _color && next.leftEdge.has_value() && !next.leftEdge->isLeft)
+            {
+                rightChain++;
+                hasNext = stream.next(next);
+            }
+            for (size_t i = rightChain; i > 0; --i)
+            {
+                sink(currentId + i);
+            }
+            sink(currentId);
+            for (size_t i = 1; i <= leftChain; ++i)
+            {
+                sink(currentId - i);
+            }
+            run += rightChain + 1 + leftChain;
+            // Colored by the last node removed at its left, whose removal cut the nodes at the left from the sweep
+            if (hasNext && next.color.has_value() && next.leftEdge.has_value() && !next.leftEdge->isLeft)
+            {
+                next.color = next.leftEdge->color;
+            }
+            currentId += rightChain + 1;
+            leftChain = 0;
+        } else
+        {
+            leftChain = current.color.has_value() && hasNext && next.color.has_value() && isLeftOfColor(next)
+                        ? leftChain + 1 : 0;
+            currentId++;
+        }
+        if (!hasNext)
+        {
+            break;
+        }
+        current = next;
+        hasNext = stream.next(next);
+    }
+    return run;
+}
+
+bool StreamingFlatGraphSolver::isLeftOfColor(const FlatGraphStream::Element &element) const
+{
+    return element.leftEdge.has_value() && element.leftEdge->isLeft && element.leftEdge->color == _color;
+}
@@ -0,0 +1,30 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_STREAMINGFLATGRAPHSOLVER_H
+#define RED_BLUE_GRAPH_SOLVER_1_STREAMINGFLATGRAPHSOLVER_H
+
+#include "FlatGraphStream.h"
+
+// The sweep of FlatGraph::getSequenceMax over a FlatGraphStream, in constant memory whatever the number of nodes.
+// The sweep only goes back through a chain of edges of the color going left, whose nodes are all of the other color
+// (a node of the color is removed as soon as the sweep reaches it), and it only looks ahead through a chain of nodes
+// of the color whose edges go right: both chains are removed whole, so their lengths are all the sweep needs. The
+// nodes are given to the sink in the order of the sequence, as soon as they are removed.
+class StreamingFlatGraphSolver
+{
+public:
+    using Sink = GraphInterface::SequenceSink;
+
+    StreamingFlatGraphSolver() = delete;
+    explicit StreamingFlatGraphSolver(GraphInterface::Color color);
+    StreamingFlatGraphSolver(const StreamingFlatGraphSolver &otherSolver) = default;
+    ~StreamingFlatGraphSolver() = default;
+
+    // Returns the run, the number of nodes of the color removed
+    size_t solve(FlatGraphStream &stream, const Sink &sink) const;
+
+private:
+    GraphInterface::Color _color;
+
+    [[nodiscard]] bool isLeftOfColor(const FlatGraphStream::Element &element) const;
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_STREAMINGFLATGRAPHSOLVER_H
@@ -0,0 +1,102 @@
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(size_t capacity)
+{
+    size_t bucketCount = getBucketCount(capacity);
+    _buckets.reset(new Bucket[bucketCount]);
+    _bucketMask = bucketCount - 1;
+    clear();
+}
+
+std::optional<TranspositionTable::Entry> TranspositionTable::probe(uint64_t key) const
+{
+    const Bucket &bucket = _buckets[key & _bucketMask];
+    for (const Slot &slot: bucket.slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((data & VALID) && (check ^ data) == key)
+        {
+            return unpack(data);
+        }
+    }
+    return std::nullopt;
+}
+
+void TranspositionTable::store(uint64_t key, Entry entry)
+{
+    Bucket &bucket = _buckets[key & _bucketMask];
+    Slot *target = nullptr;
+    int targetDepth = 0;
+    for (Slot &slot: bucket.slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((data & VALID) && (check ^ data) == key)
+        {
+            if (unpack(data).depth > entry.depth)
+            {
+                return;
+            }
+            target = &slot;
+            break;
+        }
+        // An empty slot is taken before any entry
+        int depth = (data & VALID) ? unpack(data).depth : -1;
+        if (target == nullptr || depth < targetDepth)
+        {
+            target = &slot;
+            targetDepth = depth;
+        }
+    }
+    uint64_t data = pack(entry);
+    target->data.store(data, std::memory_order_relaxed);
+    target->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i <= _bucketMask; ++i)
+    {
+        for (Slot &slot: _buckets[i].slots)
+        {
+            slot.data.store(0, std::memory_order_relaxed);
+            slot.check.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t TranspositionTable::getCapacity() const
+{
+    return (_bucketMask + 1) * BUCKET_SIZE;
+}
+
+size_t TranspositionTable::getMemoryUsage() const
+{
+    return (_bucketMask + 1) * sizeof(Bucket);
+}
+
+size_t TranspositionTable::getMemoryUsage(size_t capacity)
+{
+    return getBucketCount(capacity) * sizeof(Bucket);
+}
+
+size_t TranspositionTable::getBucketCount(size_t capacity)
+{
+    size_t bucketCount = 1;
+    while (bucketCount * BUCKET_SIZE < capacity)
+    {
+        bucketCount *= 2;
+    }
+    return bucketCount;
+}
+
+uint64_t TranspositionTable::pack(Entry entry)
+{
+    return VALID | uint64_t(entry.run) | (uint64_t(entry.bound) << 16) | (uint64_t(entry.depth) << 32);
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t data)
+{
+    return Entry{static_cast<uint16_t>(data), static_cast<uint16_t>(data >> 16), static_cast<uint16_t>(data >> 32)};
+}
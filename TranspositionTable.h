@@ -0,0 +1,76 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_TRANSPOSITIONTABLE_H
+#define RED_BLUE_GRAPH_SOLVER_1_TRANSPOSITIONTABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// Fixed-size table of search results keyed by the 64-bit hash of a state (CompactGraph::hash), shared by any number
+// of threads without locks. Each slot is two relaxed atomic words, the packed entry and the key xor the entry: a slot
+// read while another thread writes it does not match its key and is a miss, never a wrong entry. A bucket is one
+// cache line of slots and a new entry replaces the entry of the same key, or else the one searched the least deep.
+class TranspositionTable
+{
+public:
+    struct Entry
+    {
+        // Run known to be reachable from the state
+        uint16_t run;
+        // Run that cannot be beaten from the state
+        uint16_t bound;
+        // Number of removals the state was searched for, the deeper entries being kept
+        uint16_t depth;
+    };
+
+    static constexpr size_t BUCKET_SIZE = 4;
+
+    TranspositionTable() = delete;
+
+    // The capacity is rounded up to a power of two buckets
+    explicit TranspositionTable(size_t capacity);
+
+    TranspositionTable(const TranspositionTable &otherTable) = delete;
+
+    ~TranspositionTable() = default;
+
+    [[nodiscard]] std::optional<Entry> probe(uint64_t key) const;
+
+    // The entry is dropped when the table holds a deeper one for the same key
+    void store(uint64_t key, Entry entry);
+
+    void clear();
+
+    [[nodiscard]] size_t getCapacity() const;
+
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+    // Memory usage of a table of the capacity, before allocating it
+    [[nodiscard]] static size_t getMemoryUsage(size_t capacity);
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket
+    {
+        std::array<Slot, BUCKET_SIZE> slots;
+    };
+
+    static constexpr uint64_t VALID = uint64_t(1) << 48;
+
+    std::unique_ptr<Bucket[]> _buckets;
+    size_t _bucketMask;
+
+    [[nodiscard]] static size_t getBucketCount(size_t capacity);
+
+    [[nodiscard]] static uint64_t pack(Entry entry);
+
+    [[nodiscard]] static Entry unpack(uint64_t data);
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_TRANSPOSITIONTABLE_H
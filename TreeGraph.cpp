@@ -0,0 +1,565 @@
+#include <iostream>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include "TreeGraph.h"
+
+namespace
+{
+    // Colors given to a node of the run by its in-neighbors removed before it, as a pair of levels
+    // (none / other color only / the color at least once) for the run and for the prefix: flags = run * 3 + prefix.
+    // The last painter comes from the run if any in-neighbor of the run was removed before the node, from the
+    // prefix otherwise, and inside a level the painters can be ordered so that a good one is the last.
+    constexpr int FLAG_COUNT = 9;
+    constexpr int IN_FLAG_COUNT = 5;
+    constexpr int32_t IMPOSSIBLE = std::numeric_limits<int32_t>::min() / 4;
+
+    enum Category : uint8_t
+    {
+        PREFIX,
+        NOT_REMOVED,
+        RUN_BEFORE_PARENT,
+        RUN_AFTER_PARENT
+    };
+
+    int mergeFlags(int flags1, int flags2)
+    {
+        return std::max(flags1 / 3, flags2 / 3) * 3 + std::max(flags1 % 3, flags2 % 3);
+    }
+
+    int prefixFlag(bool good)
+    {
+        return good ? 2 : 1;
+    }
+
+    int runFlag(bool good)
+    {
+        return (good ? 2 : 1) * 3;
+    }
+
+    // The parent gives no color, a color as part of the prefix or a color as part of the run
+    int inFlagIndex(int flags)
+    {
+        switch (flags)
+        {
+            case 2:
+                return 1;
+            case 1:
+                return 2;
+            case 6:
+                return 3;
+            case 3:
+                return 4;
+            default:
+                return 0;
+        }
+    }
+
+    constexpr int IN_FLAGS[IN_FLAG_COUNT] = {0, 2, 1, 6, 3};
+
+    bool isGoodAtRemoval(int flags, bool initiallyGood)
+    {
+        if (flags / 3 != 0)
+        {
+            return flags / 3 == 2;
+        }
+        if (flags % 3 != 0)
+        {
+            return flags % 3 == 2;
+        }
+        return initiallyGood;
+    }
+
+    struct Adjacency
+    {
+        uint32_t node;
+        bool toNode; // edge oriented from the node owning the adjacency list to this node
+        bool good;
+    };
+
+    struct Option
+    {
+        Category category;
+        int32_t value;
+        int flagsToParent;
+        int inFlagIndex;
+    };
+
+    bool isRun(Category category)
+    {
+        return category == RUN_BEFORE_PARENT || category == RUN_AFTER_PARENT;
+    }
+}
+
+TreeGraph::TreeGraph(size_t maxCapacity) : _maxCapacity(maxCapacity)
+{
+    if (maxCapacity >= std::numeric_limits<uint32_t>::max())
+    {
+        throw GraphInterface::GraphModificationException("Max capacity is too big.");
+    }
+    _nodes.resize(maxCapacity);
+    _components.resize(maxCapacity);
+    for (size_t i = 0; i < maxCapacity; ++i)
+    {
+        _components[i] = static_cast<uint32_t>(i);
+    }
+}
+
+void TreeGraph::createNode(const GraphInterface::Color &color, size_t id)
+{
+    if (id >= _maxCapacity)
+    {
+        throw GraphInterface::GraphModificationException("Node id is too big.");
+    }
+    if (nodeExists(id))
+    {
+        throw GraphInterface::GraphModificationException("Node already exists.");
+    }
+    _nodes[id] = TreeGraphNode{color};
+    _size++;
+}
+
+void TreeGraph::addEdge(size_t from, size_t to, const GraphInterface::Color &color)
+{
+    if (!nodeExists(from) || !nodeExists(to) || from == to)
+    {
+        throw GraphInterface::GraphModificationException("Node does not exist.");
+    }
+    uint32_t fromComponent = findComponent(static_cast<uint32_t>(from));
+    uint32_t toComponent = findComponent(static_cast<uint32_t>(to));
+    if (fromComponent == toComponent)
+    {
+        throw GraphInterface::GraphModificationException("Edge would create a cycle.");
+    }
+    _components[fromComponent] = toComponent;
+    _edges.push_back(TreeGraphEdge{from, to, color});
+}
+
+bool TreeGraph::nodeExists(size_t id) const
+{
+    return id < _maxCapacity && _nodes[id].has_value();
+}
+
+void TreeGraph::removeNode(size_t id)
+{
+    if (!nodeExists(id))
+    {
+        throw GraphInterface::GraphModificationException("Node does not exist.");
+    }
+    for (const TreeGraphEdge &edge: _edges)
+    {
+        if (edge.from == id)
+        {
+            _nodes[edge.to]->color = edge.color;
+        }
+    }
+    _edges.erase(std::remove_if(_edges.begin(), _edges.end(), [id](const TreeGraphEdge &edge) {
+        return edge.from == id || edge.to == id;
+    }), _edges.end());
+    _nodes[id] = std::nullopt;
+    _size--;
+    rebuildComponents();
+}
+
+bool TreeGraph::isEmpty() const
+{
+    return _size == 0;
+}
+
+size_t TreeGraph::getMaxCapacity() const
+{
+    return _maxCapacity;
+}
+
+size_t TreeGraph::size() const
+{
+    return _size;
+}
+
+uint32_t TreeGraph::findComponent(uint32_t id)
+{
+    while (_components[id] != id)
+    {
+        _components[id] = _components[_components[id]];
+        id = _components[id];
+    }
+    return id;
+}
+
+void TreeGraph::rebuildComponents()
+{
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        _components[i] = static_cast<uint32_t>(i);
+    }
+    for (const TreeGraphEdge &edge: _edges)
+    {
+        _components[findComponent(static_cast<uint32_t>(edge.from))] = findComponent(static_cast<uint32_t>(edge.to));
+    }
+}
+
+std::pair<size_t, std::deque<size_t>> TreeGraph::getSequenceMax(const GraphInterface::Color &color) const
+{
+    // Undirected adjacency in CSR form
+    std::vector<uint32_t> offsets(_maxCapacity + 1, 0);
+    for (const TreeGraphEdge &edge: _edges)
+    {
+        offsets[edge.from + 1]++;
+        offsets[edge.to + 1]++;
+    }
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<Adjacency> adjacency(offsets[_maxCapacity]);
+    {
+        std::vector<uint32_t> positions(offsets.begin(), offsets.end() - 1);
+        for (const TreeGraphEdge &edge: _edges)
+        {
+            bool good = edge.color == color;
+            adjacency[positions[edge.from]++] = Adjacency{static_cast<uint32_t>(edge.to), true, good};
+            adjacency[positions[edge.to]++] = Adjacency{static_cast<uint32_t>(edge.from), false, good};
+        }
+    }
+
+    // Breadth first order of every tree, parents before children
+    constexpr uint32_t NO_PARENT = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> order;
+    order.reserve(_size);
+    std::vector<uint32_t> parents(_maxCapacity, NO_PARENT);
+    std::vector<bool> visited(_maxCapacity, false);
+    for (size_t root = 0; root < _maxCapacity; ++root)
+    {
+        if (!nodeExists(root) || visited[root])
+        {
+            continue;
+        }
+        visited[root] = true;
+        size_t head = order.size();
+        order.push_back(static_cast<uint32_t>(root));
+        while (head < order.size())
+        {
+            uint32_t current = order[head++];
+            for (uint32_t a = offsets[current]; a < offsets[current + 1]; ++a)
+            {
+                if (!visited[adjacency[a].node])
+                {
+                    visited[adjacency[a].node] = true;
+                    parents[adjacency[a].node] = current;
+                    order.push_back(adjacency[a].node);
+                }
+            }
+        }
+    }
+
+    // Best number of run nodes in the subtree of each node, for each role of the node
+    std::vector<int32_t> prefixValues(_maxCapacity, 0);
+    std::vector<int32_t> notRemovedValues(_maxCapacity, 0);
+    std::vector<std::array<int32_t, IN_FLAG_COUNT>> runValues(_maxCapacity);
+
+    // Options of a child given the category of its parent, the flags it gives to its parent and the flags it gets
+    auto childOptions = [&](uint32_t child, const Adjacency &fromParent, Category parentCategory,
+                            Option (&options)[4]) {
+        bool childToParent = !fromParent.toNode;
+        int parentFlags = 0;
+        if (parentCategory == PREFIX && fromParent.toNode)
+        {
+            parentFlags = prefixFlag(fromParent.good);
+        }
+        options[0] = Option{PREFIX, prefixValues[child],
+                            isRun(parentCategory) && childToParent ? prefixFlag(fromParent.good) : 0, 0};
+        options[1] = Option{NOT_REMOVED, notRemovedValues[child], 0, 0};
+        if (!isRun(parentCategory))
+        {
+            options[2] = Option{RUN_BEFORE_PARENT, runValues[child][inFlagIndex(parentFlags)], 0,
+                                inFlagIndex(parentFlags)};
+            return 3;
+        }
+        options[2] = Option{RUN_BEFORE_PARENT, runValues[child][0], childToParent ? runFlag(fromParent.good) : 0, 0};
+        int afterIndex = fromParent.toNode ? inFlagIndex(runFlag(fromParent.good)) : 0;
+        options[3] = Option{RUN_AFTER_PARENT, runValues[child][afterIndex], 0, afterIndex};
+        return 4;
+    };
+
+    // Knapsack over the children of a run node on the flags they give to it
+    auto runKnapsack = [&](uint32_t node, std::vector<std::array<uint8_t, FLAG_COUNT>> *choices) {
+        std::array<int32_t, FLAG_COUNT> best{};
+        best.fill(IMPOSSIBLE);
+        best[0] = 0;
+        Option options[4];
+        for (uint32_t a = offsets[node]; a < offsets[node + 1]; ++a)
+        {
+            uint32_t child = adjacency[a].node;
+            if (parents[child] != node)
+            {
+                continue;
+            }
+            int optionCount = childOptions(child, adjacency[a], RUN_AFTER_PARENT, options);
+            std::array<int32_t, FLAG_COUNT> next{};
+            next.fill(IMPOSSIBLE);
+            std::array<uint8_t, FLAG_COUNT> choice{};
+            for (int flags = 0; flags < FLAG_COUNT; ++flags)
+            {
+                if (best[flags] == IMPOSSIBLE)
+                {
+                    continue;
+                }
+                for (int o = 0; o < optionCount; ++o)
+                {
+                    if (options[o].value == IMPOSSIBLE)
+                    {
+                        continue;
+                    }
+                    int merged = mergeFlags(flags, options[o].flagsToParent);
+                    if (best[flags] + options[o].value > next[merged])
+                    {
+                        next[merged] = best[flags] + options[o].value;
+                        choice[merged] = static_cast<uint8_t>(o * FLAG_COUNT + flags);
+                    }
+                }
+            }
+            best = next;
+            if (choices != nullptr)
+            {
+                choices->push_back(choice);
+            }
+        }
+        return best;
+    };
+
+    auto bestChildOption = [&](uint32_t child, const Adjacency &fromParent, Category parentCategory) {
+        Option options[4];
+        int optionCount = childOptions(child, fromParent, parentCategory, options);
+        int bestOption = 0;
+        for (int o = 1; o < optionCount; ++o)
+        {
+            if (options[o].value > options[bestOption].value)
+            {
+                bestOption = o;
+            }
+        }
+        return options[bestOption];
+    };
+
+    for (size_t i = order.size(); i-- > 0;)
+    {
+        uint32_t node = order[i];
+        int32_t prefixValue = 0, notRemovedValue = 0;
+        for (uint32_t a = offsets[node]; a < offsets[node + 1]; ++a)
+        {
+            if (parents[adjacency[a].node] == node)
+            {
+                prefixValue += bestChildOption(adjacency[a].node, adjacency[a], PREFIX).value;
+                notRemovedValue += bestChildOption(adjacency[a].node, adjacency[a], NOT_REMOVED).value;
+            }
+        }
+        prefixValues[node] = prefixValue;
+        notRemovedValues[node] = notRemovedValue;
+        std::array<int32_t, FLAG_COUNT> best = runKnapsack(node, nullptr);
+        bool initiallyGood = _nodes[node]->color == color;
+        for (int in = 0; in < IN_FLAG_COUNT; ++in)
+        {
+            int32_t value = IMPOSSIBLE;
+            for (int flags = 0; flags < FLAG_COUNT; ++flags)
+            {
+                if (best[flags] != IMPOSSIBLE && isGoodAtRemoval(mergeFlags(flags, IN_FLAGS[in]), initiallyGood))
+                {
+                    value = std::max(value, best[flags] + 1);
+                }
+            }
+            runValues[node][in] = value;
+        }
+    }
+
+    // Top down choice of the role of every node
+    std::vector<Category> categories(_maxCapacity, NOT_REMOVED);
+    std::vector<uint8_t> inFlags(_maxCapacity, 0);
+    std::vector<std::array<uint8_t, FLAG_COUNT>> choices;
+    for (uint32_t node: order)
+    {
+        if (parents[node] == NO_PARENT)
+        {
+            categories[node] = NOT_REMOVED;
+            if (prefixValues[node] > notRemovedValues[node])
+            {
+                categories[node] = PREFIX;
+            }
+            if (runValues[node][0] > std::max(prefixValues[node], notRemovedValues[node]))
+            {
+                categories[node] = RUN_BEFORE_PARENT;
+            }
+        }
+        if (!isRun(categories[node]))
+        {
+            for (uint32_t a = offsets[node]; a < offsets[node + 1]; ++a)
+            {
+                if (parents[adjacency[a].node] == node)
+                {
+                    Option option = bestChildOption(adjacency[a].node, adjacency[a], categories[node]);
+                    categories[adjacency[a].node] = option.category;
+                    inFlags[adjacency[a].node] = static_cast<uint8_t>(option.inFlagIndex);
+                }
+            }
+            continue;
+        }
+        choices.clear();
+        std::array<int32_t, FLAG_COUNT> best = runKnapsack(node, &choices);
+        bool initiallyGood = _nodes[node]->color == color;
+        int flags = -1;
+        for (int f = 0; f < FLAG_COUNT; ++f)
+        {
+            if (best[f] != IMPOSSIBLE && isGoodAtRemoval(mergeFlags(f, IN_FLAGS[inFlags[node]]), initiallyGood)
+                && (flags < 0 || best[f] > best[flags]))
+            {
+                flags = f;
+            }
+        }
+        size_t childIndex = choices.size();
+        for (uint32_t a = offsets[node + 1]; a-- > offsets[node];)
+        {
+            uint32_t child = adjacency[a].node;
+            if (parents[child] != node)
+            {
+                continue;
+            }
+            uint8_t choice = choices[--childIndex][flags];
+            Option options[4];
+            childOptions(child, adjacency[a], RUN_AFTER_PARENT, options);
+            categories[child] = options[choice / FLAG_COUNT].category;
+            inFlags[child] = static_cast<uint8_t>(options[choice / FLAG_COUNT].inFlagIndex);
+            flags = choice % FLAG_COUNT;
+        }
+    }
+
+    // Removal order: prefix nodes then run nodes, each level in a topological order of the constraints "removed
+    // before" of the run edges and of the painters that must be the last ones
+    auto isEarlierInNeighbor = [&](uint32_t node, const Adjacency &adjacent) {
+        uint32_t neighbor = adjacent.node;
+        if (adjacent.toNode || categories[neighbor] == NOT_REMOVED)
+        {
+            return false;
+        }
+        if (categories[neighbor] == PREFIX)
+        {
+            return true;
+        }
+        if (parents[neighbor] == node)
+        {
+            return categories[neighbor] == RUN_BEFORE_PARENT;
+        }
+        return categories[node] == RUN_AFTER_PARENT;
+    };
+    std::vector<std::pair<uint32_t, uint32_t>> constraints;
+    for (uint32_t node: order)
+    {
+        if (!isRun(categories[node]))
+        {
+            continue;
+        }
+        if (parents[node] != NO_PARENT && isRun(categories[parents[node]]))
+        {
+            if (categories[node] == RUN_BEFORE_PARENT)
+            {
+                constraints.emplace_back(node, parents[node]);
+            } else
+            {
+                constraints.emplace_back(parents[node], node);
+            }
+        }
+        bool runPainters = false;
+        for (uint32_t a = offsets[node]; a < offsets[node + 1]; ++a)
+        {
+            if (isEarlierInNeighbor(node, adjacency[a]) && isRun(categories[adjacency[a].node]))
+            {
+                runPainters = true;
+            }
+        }
+        uint32_t painter = NO_PARENT;
+        for (uint32_t a = offsets[node]; a < offsets[node + 1]; ++a)
+        {
+            if (isEarlierInNeighbor(node, adjacency[a]) && isRun(categories[adjacency[a].node]) == runPainters
+                && adjacency[a].good)
+            {
+                painter = adjacency[a].node;
+            }
+        }
+        for (uint32_t a = offsets[node]; a < offsets[node + 1]; ++a)
+        {
+            uint32_t neighbor = adjacency[a].node;
+            if (neighbor != painter && isEarlierInNeighbor(node, adjacency[a])
+                && isRun(categories[neighbor]) == runPainters && painter != NO_PARENT)
+            {
+                constraints.emplace_back(neighbor, painter);
+            }
+        }
+    }
+    std::vector<uint32_t> constraintOffsets(_maxCapacity + 1, 0);
+    std::vector<uint32_t> constraintTargets(constraints.size());
+    std::vector<uint32_t> pendingCounts(_maxCapacity, 0);
+    for (const std::pair<uint32_t, uint32_t> &constraint: constraints)
+    {
+        constraintOffsets[constraint.first + 1]++;
+        pendingCounts[constraint.second]++;
+    }
+    for (size_t i = 0; i < _maxCapacity; ++i)
+    {
+        constraintOffsets[i + 1] += constraintOffsets[i];
+    }
+    {
+        std::vector<uint32_t> positions(constraintOffsets.begin(), constraintOffsets.end() - 1);
+        for (const std::pair<uint32_t, uint32_t> &constraint: constraints)
+        {
+            constraintTargets[positions[constraint.first]++] = constraint.second;
+        }
+    }
+    std::deque<size_t> sequence;
+    size_t run = 0;
+    for (bool runLevel: {false, true})
+    {
+        std::vector<uint32_t> ready;
+        for (uint32_t node: order)
+        {
+            if (categories[node] != NOT_REMOVED && isRun(categories[node]) == runLevel && pendingCounts[node] == 0)
+            {
+                ready.push_back(node);
+            }
+        }
+        while (!ready.empty())
+        {
+            uint32_t node = ready.back();
+            ready.pop_back();
+            sequence.push_back(node);
+            run += runLevel ? 1 : 0;
+            for (uint32_t c = constraintOffsets[node]; c < constraintOffsets[node + 1]; ++c)
+            {
+                if (--pendingCounts[constraintTargets[c]] == 0)
+                {
+                    ready.push_back(constraintTargets[c]);
+                }
+            }
+        }
+    }
+    return std::make_pair(run, sequence);
+}
+
+std::ostream &operator<<(std::ostream &os, const TreeGraph &graph)
+{
+    for (size_t i = 0; i < graph._maxCapacity; ++i)
+    {
+        if (!graph.nodeExists(i))
+        {
+            continue;
+        }
+        os << "Node " << i << " (" << GraphInterface::getColorName(graph._nodes[i]->color) << "): "
+           << std::endl;
+        for (const TreeGraph::TreeGraphEdge &edge: graph._edges)
+        {
+            if (edge.from == i)
+            {
+                os << "\t--- " << GraphInterface::getColorName(edge.color) << " ---> Node "
+                   << edge.to << std::endl;
+            }
+        }
+    }
+    return os;
+}
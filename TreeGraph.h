@@ -0,0 +1,64 @@
+#ifndef RED_BLUE_GRAPH_SOLVER_1_TREEGRAPH_H
+#define RED_BLUE_GRAPH_SOLVER_1_TREEGRAPH_H
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+#include "GraphInterface.h"
+
+// Graph whose undirected edges form a forest, each edge being oriented either way. The maximum sequence is computed
+// exactly in linear time by a dynamic programming over the rooted trees: every node is either removed before the
+// run (only to give its colors), removed in the run or not removed, and a node of the run must end up of the color
+// given by the last of its in-neighbors removed before it (or keep its own color if there is none).
+class TreeGraph : public GraphInterface
+{
+public:
+    TreeGraph() = delete;
+    explicit TreeGraph(size_t maxCapacity);
+    TreeGraph(const TreeGraph &otherGraph) = default;
+    TreeGraph &operator=(const TreeGraph &other) = default;
+    ~TreeGraph() = default;
+
+    void createNode(const GraphInterface::Color &color, size_t id);
+
+    void addEdge(size_t from, size_t to, const GraphInterface::Color &color);
+
+    [[nodiscard]] bool nodeExists(size_t id) const;
+
+    void removeNode(size_t id);
+
+    [[nodiscard]] bool isEmpty() const;
+
+    [[nodiscard]] size_t getMaxCapacity() const;
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] std::pair<size_t, std::deque<size_t>> getSequenceMax(const GraphInterface::Color &color) const;
+
+    friend std::ostream &operator<<(std::ostream &os, const TreeGraph &graph);
+
+private:
+    struct TreeGraphNode
+    {
+        GraphInterface::Color color;
+    };
+    struct TreeGraphEdge
+    {
+        size_t from;
+        size_t to;
+        GraphInterface::Color color;
+    };
+
+    size_t _maxCapacity;
+    size_t _size = 0;
+    std::vector<std::optional<TreeGraphNode>> _nodes;
+    std::vector<TreeGraphEdge> _edges;
+    std::vector<uint32_t> _components;
+
+    [[nodiscard]] uint32_t findComponent(uint32_t id);
+
+    void rebuildComponents();
+};
+
+#endif //RED_BLUE_GRAPH_SOLVER_1_TREEGRAPH_H
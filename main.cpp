@@ -1,20 +1,168 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <iostream>
+#include <optional>
 #include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 #include "Graph.h"
 #include "FlatGraph.h"
+#include "FlatGraphGenerator.h"
+#include "MonteCarloSweep.h"
+#include "CoupledFlatGraphGenerator.h"
+#include "StreamingFlatGraphSolver.h"
+#include "ShardedSweep.h"
+#include "SolverServer.h"
+#include "TranspositionTable.h"
 #include "compilation_infos.h"
 
 void graphTest();
 
-void flatGraphTest();
+void flatGraphTest(bool coupled);
 
-int main()
+void transpositionTableBenchmark(size_t maxThreadCount);
+
+void streamSolve(const std::string &path);
+
+bool shardedSweep(const std::string &executable, const std::string &directory, size_t workerCount,
+                  std::optional<size_t> shardCount);
+
+bool parseCount(const char *text, size_t &count);
+
+int main(int argc, char *argv[])
 {
+    // --serve <socket path> [--workers <count>] [--memory <bytes per search>] runs the solver daemon instead of the
+    // experiments
+    if (argc >= 3 && std::strcmp(argv[1], "--serve") == 0)
+    {
+        size_t workerCount = std::max(1u, std::thread::hardware_concurrency());
+        size_t memoryBudget = MemoryBudget::UNLIMITED;
+        for (int i = 3; i + 1 < argc; i += 2)
+        {
+            if (std::strcmp(argv[i], "--workers") == 0 && !parseCount(argv[i + 1], workerCount))
+            {
+                std::cerr << "Nombre de workers invalide : " << argv[i + 1] << std::endl;
+                return 1;
+            } else if (std::strcmp(argv[i], "--memory") == 0 && !parseCount(argv[i + 1], memoryBudget))
+            {
+                std::cerr << "Budget memoire invalide : " << argv[i + 1] << std::endl;
+                return 1;
+            }
+        }
+        SolverServer server(argv[2], workerCount, 1 << 16, memoryBudget);
+        std::cout << "Serveur en ecoute sur " << argv[2] << " avec " << workerCount << " workers" << std::endl;
+        server.run();
+        return 0;
+    }
+    // --bench-tt [max thread count] measures the transposition table from 1 thread to the max (64 by default)
+    if (argc >= 2 && std::strcmp(argv[1], "--bench-tt") == 0)
+    {
+        size_t maxThreadCount = 64;
+        if (argc >= 3 && !parseCount(argv[2], maxThreadCount))
+        {
+            std::cerr << "Usage : " << argv[0] << " --bench-tt [nombre maximal de threads]" << std::endl;
+            return 1;
+        }
+        transpositionTableBenchmark(maxThreadCount);
+        return 0;
+    }
+    // --stream <file or - for stdin> solves a flat graph given as a byte stream, writing the red sequence as it goes
+    if (argc >= 3 && std::strcmp(argv[1], "--stream") == 0)
+    {
+        streamSolve(argv[2]);
+        return 0;
+    }
+    // --sweep <directory> [--workers <count>] [--shards <count>] runs the sweep of flatGraphTest in worker processes,
+    // resuming the sweep already in the directory if any
+    if (argc >= 3 && std::strcmp(argv[1], "--sweep") == 0)
+    {
+        size_t workerCount = std::max(1u, std::thread::hardware_concurrency());
+        std::optional<size_t> shardCount;
+        for (int i = 3; i + 1 < argc; i += 2)
+        {
+            if (std::strcmp(argv[i], "--workers") == 0 && !parseCount(argv[i + 1], workerCount))
+            {
+                std::cerr << "Nombre de workers invalide : " << argv[i + 1] << std::endl;
+                return 1;
+            } else if (std::strcmp(argv[i], "--shards") == 0 && !parseCount(argv[i + 1], shardCount.emplace()))
+            {
+                std::cerr << "Nombre de shards invalide : " << argv[i + 1] << std::endl;
+                return 1;
+            }
+        }
+        return shardedSweep(argv[0], argv[2], workerCount, shardCount) ? 0 : 1;
+    }
+    // --sweep-worker <directory> <shard> runs one shard of the sweep of the directory, for the coordinator
+    if (argc >= 4 && std::strcmp(argv[1], "--sweep-worker") == 0)
+    {
+        size_t shard;
+        if (!parseCount(argv[3], shard))
+        {
+            std::cerr << "Shard invalide : " << argv[3] << std::endl;
+            return 1;
+        }
+        ShardedSweep(argv[2]).runShard(shard);
+        return 0;
+    }
     //graphTest();
-    flatGraphTest();
+    flatGraphTest(argc >= 2 && std::strcmp(argv[1], "--coupled") == 0);
     return 0;
 }
 
+void transpositionTableBenchmark(size_t maxThreadCount)
+{
+    // Every thread probes then stores random keys of a key space shared by the threads, so that they read the entries
+    // written by the others
+    constexpr size_t OPERATION_COUNT = 1 << 22;
+    constexpr uint64_t KEY_SPACE = 1 << 23;
+    TranspositionTable table(1 << 22);
+    std::cout << "Table de transposition de " << table.getCapacity() << " entrees" << std::endl;
+    for (size_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+    {
+        table.clear();
+        std::atomic<size_t> hitCount(0);
+        std::vector<std::thread> threads;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&table, &hitCount, t]()
+            {
+                uint64_t random = 0x9E3779B97F4A7C15ull * (t + 1);
+                size_t hits = 0;
+                for (size_t i = 0; i < OPERATION_COUNT; ++i)
+                {
+                    random ^= random << 13;
+                    random ^= random >> 7;
+                    random ^= random << 17;
+                    uint64_t key = (random % KEY_SPACE) * 0xBF58476D1CE4E5B9ull;
+                    key ^= key >> 31;
+                    std::optional<TranspositionTable::Entry> entry = table.probe(key);
+                    if (entry.has_value())
+                    {
+                        hits++;
+                    }
+                    uint16_t depth = static_cast<uint16_t>(random >> 48) & 63;
+                    table.store(key, TranspositionTable::Entry{static_cast<uint16_t>(i), depth, depth});
+                }
+                hitCount += hits;
+            });
+        }
+        for (std::thread &thread: threads)
+        {
+            thread.join();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double operationCount = 2.0 * OPERATION_COUNT * threadCount;
+        std::cout << threadCount << " threads : " << operationCount / seconds / 1e6 << " Mops/s, "
+                  << 100.0 * hitCount / (OPERATION_COUNT * threadCount) << " % de succes" << std::endl;
+    }
+}
+
 void graphTest()
 {
     Graph graph(9);
@@ -72,7 +220,7 @@ void graphTest()
               << " micro-s" << std::endl;
 }
 
-void flatGraphTest()
+void flatGraphTest(bool coupled)
 {
     FlatGraph flatGraph(100);
     /*flatGraph.createNode(GraphInterface::Color::RED, 0);
@@ -106,7 +254,8 @@ void flatGraphTest()
     flatGraph.addEdge(6, 5, GraphInterface::Color::BLUE);
     flatGraph.addEdge(6, 7, GraphInterface::Color::RED);*/
 
-    flatGraph.generateRandom();
+    FlatGraphGenerator generator(static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()));
+    generator.generate(flatGraph);
 
     //std::cout << flatGraph << std::endl;
 
@@ -114,32 +263,59 @@ void flatGraphTest()
     std::cout << "Compilation: " << (DEBUG ? "DEBUG" : "RELEASE") << std::endl;
     std::cout << GET_COMPILER_NAME() << " " << GET_BUILD_ARCHITECTURE() << " " << GET_OS() << std::endl;
 
-    double results[2][11][11] = {0};
-
+    // Each cell is sampled until the 95 % intervals of both means are within TARGET_HALF_WIDTH nodes, the width that
+    // 100 trials per cell gave to the noisiest cells, with at most the budget of 100 trials per cell
     constexpr int N = 100;
-    for (int pi = 0; pi <= 10; pi++)
+    constexpr double TARGET_HALF_WIDTH = 1.75;
+    MonteCarloSweep sweep(11 * 11, 2, TARGET_HALF_WIDTH, N * 11 * 11);
+    if (coupled)
     {
-        double p = pi / 10.0;
-        for (int qi = 0; qi <= 10; qi++)
+        // One draw per trial for all the cells, walked row by row in alternating directions so that each cell only
+        // recolors the nodes and edges between its probabilities and the previous ones
+        CoupledFlatGraphGenerator coupledGenerator(
+                static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count()));
+        sweep.runCoupled([&flatGraph, &coupledGenerator](const std::vector<bool> &cells, std::vector<double> &samples)
         {
-            double q = qi / 10.0;
-
-            int sum1 = 0, sum2 = 0;
-
-            for (int i = 0; i < N; i++)
+            coupledGenerator.draw(flatGraph, 0, 0, 0.5);
+            // Sequence sizes of the last cell solved, valid while the graph is unchanged
+            std::optional<std::pair<double, double>> sizes;
+            for (int pi = 0; pi <= 10; pi++)
             {
-                flatGraph.generateRandom(p, q, 0.5);
-
-                std::deque<size_t> sequenceMaxRed;
-                sequenceMaxRed = flatGraph.getSequenceMax(GraphInterface::Color::RED);
-                sum1 += sequenceMaxRed.size();
-                sequenceMaxRed = flatGraph.getSequenceMaxBis(GraphInterface::Color::RED);
-                sum2 += sequenceMaxRed.size();
+                for (int j = 0; j <= 10; j++)
+                {
+                    int qi = pi % 2 == 0 ? j : 10 - j;
+                    size_t cell = pi * 11 + qi;
+                    if (coupledGenerator.update(flatGraph, pi / 10.0, qi / 10.0) > 0)
+                    {
+                        sizes.reset();
+                    }
+                    if (!cells[cell])
+                    {
+                        continue;
+                    }
+                    if (!sizes)
+                    {
+                        sizes.emplace(static_cast<double>(flatGraph.getSequenceMax(GraphInterface::Color::RED).size()),
+                                      static_cast<double>(
+                                              flatGraph.getSequenceMaxBis(GraphInterface::Color::RED).size()));
+                    }
+                    samples[cell * 2] = sizes->first;
+                    samples[cell * 2 + 1] = sizes->second;
+                }
             }
+        });
+    }
+    else
+    {
+        sweep.run([&flatGraph, &generator](size_t cell, std::vector<double> &samples)
+        {
+            double p = static_cast<double>(cell / 11) / 10.0;
+            double q = static_cast<double>(cell % 11) / 10.0;
+            generator.generate(flatGraph, p, q, 0.5);
 
-            results[0][pi][qi] = sum1 / (double) N;
-            results[1][pi][qi] = sum2 / (double) N;
-        }
+            samples[0] = static_cast<double>(flatGraph.getSequenceMax(GraphInterface::Color::RED).size());
+            samples[1] = static_cast<double>(flatGraph.getSequenceMaxBis(GraphInterface::Color::RED).size());
+        });
     }
 
     for (int i = 0; i < 2; i++)
@@ -148,11 +324,12 @@ void flatGraphTest()
         {
             for (int qi = 0; qi <= 10; qi++)
             {
-                printf("%5.1f ", results[i][pi][qi]);
+                printf("%5.1f ", sweep.getStatistics(pi * 11 + qi, i).getMean());
             }
             std::cout << std::endl;
         }
     }
+    std::cout << "Essais : " << sweep.getTrialCount() << " sur " << N * 11 * 11 << std::endl;
 
     /*std::deque<size_t> sequenceMaxRed;
     auto start = std::chrono::high_resolution_clock::now();
@@ -171,4 +348,100 @@ void flatGraphTest()
         std::cout << it << " ";
     }
     std::cout << std::endl;*/
-}
\ No newline at end of file
+}
+
+void streamSolve(const std::string &path)
+{
+    std::ifstream file;
+    if (path != "-")
+    {
+        file.open(path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open " + path);
+        }
+    }
+    FlatGraphByteStream stream(path == "-" ? std::cin : file);
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t run = StreamingFlatGraphSolver(GraphInterface::Color::RED).solve(stream, [](size_t nodeId)
+    {
+        std::cout << nodeId << '\n';
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Run : " << run << std::endl;
+    std::cout << "Temps d'execution : " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " ms" << std::endl;
+}
+
+bool shardedSweep(const std::string &executable, const std::string &directory, size_t workerCount,
+                  std::optional<size_t> shardCount)
+{
+    // The grid of flatGraphTest, 100 trials of each cell
+    std::vector<double> probabilities;
+    for (int i = 0; i <= 10; i++)
+    {
+        probabilities.push_back(i / 10.0);
+    }
+    uint64_t seed = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    // A sweep resumed keeps the shards of its grid, the ones already written would not match other ones
+    ShardedSweep sweep = ShardedSweep::hasGrid(directory)
+                         ? ShardedSweep(directory)
+                         : ShardedSweep(ShardedSweep::Grid{{100}, probabilities, probabilities, 100, seed,
+                                                           shardCount.value_or(4 * workerCount)}, directory);
+    if (shardCount.has_value() && *shardCount != sweep.getGrid().shardCount)
+    {
+        std::cerr << "Le balayage de " << directory << " a deja " << sweep.getGrid().shardCount << " shards"
+                  << std::endl;
+        return false;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<size_t> failedShards = sweep.runLocal(executable, workerCount);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!failedShards.empty())
+    {
+        std::cout << failedShards.size() << " shards sur " << sweep.getGrid().shardCount << " ont echoue" << std::endl;
+        return false;
+    }
+    std::vector<ShardedSweep::Moments> moments = sweep.merge();
+    const ShardedSweep::Grid &grid = sweep.getGrid();
+    for (size_t s = 0; s < grid.sizes.size(); s++)
+    {
+        std::cout << "Graphes de taille " << grid.sizes[s] << std::endl;
+        for (size_t e = 0; e < ShardedSweep::ESTIMATOR_COUNT; e++)
+        {
+            for (size_t p = 0; p < grid.redNodeProbabilities.size(); p++)
+            {
+                for (size_t q = 0; q < grid.redEdgeProbabilities.size(); q++)
+                {
+                    printf("%5.1f ", moments[sweep.getCell(s, p, q) * ShardedSweep::ESTIMATOR_COUNT + e].getMean());
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+    std::cout << "Temps d'execution : " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " ms" << std::endl;
+    return true;
+}
+
+bool parseCount(const char *text, size_t &count)
+{
+    // std::stoul takes a leading sign and wraps a negative count around
+    if (!std::isdigit(static_cast<unsigned char>(text[0])))
+    {
+        return false;
+    }
+    try
+    {
+        size_t length;
+        count = std::stoul(text, &length);
+        return text[length] == '\0';
+    } catch (const std::invalid_argument &)
+    {
+        return false;
+    } catch (const std::out_of_range &)
+    {
+        return false;
+    }
+}